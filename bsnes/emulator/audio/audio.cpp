@@ -37,35 +37,26 @@ auto Audio::createStream(uint channels, double frequency) -> shared_pointer<Stre
 }
 
 auto Audio::process() -> void {
-  while(_streams) {
-    for(auto& stream : _streams) {
-      if(!stream->pending()) return;
-    }
+  if(!_streams) return;
 
-    double samples[_channels];
-    for(auto& sample : samples) sample = 0.0;
+  uint frames = ~0;
+  for(auto& stream : _streams) frames = min(frames, stream->pending());
+  if(!frames) return;
 
-    for(auto& stream : _streams) {
-      double buffer[_channels];
-      uint length = stream->read(buffer), offset = 0;
+  _samples.resize(frames * _channels);
+  memory::fill<double>(_samples.data(), _samples.size());
+  for(auto& stream : _streams) stream->mix(_samples.data(), frames, _channels);
 
-      for(auto& sample : samples) {
-        sample += buffer[offset];
-        if(++offset >= length) offset = 0;
-      }
-    }
-
-    for(auto c : range(_channels)) {
-      samples[c] = max(-1.0, min(+1.0, samples[c] * _volume));
-    }
-
-    if(_channels == 2) {
-      if(_balance < 0.0) samples[1] *= 1.0 + _balance;
-      if(_balance > 0.0) samples[0] *= 1.0 - _balance;
-    }
+  for(auto& sample : _samples) {
+    sample = max(-1.0, min(+1.0, sample * _volume));
+  }
 
-    platform->audioFrame(samples, _channels);
+  if(_channels == 2) {
+    if(_balance < 0.0) for(uint n : range(frames)) _samples[n * 2 + 1] *= 1.0 + _balance;
+    if(_balance > 0.0) for(uint n : range(frames)) _samples[n * 2 + 0] *= 1.0 - _balance;
   }
+
+  platform->audioFrames(_samples.data(), frames, _channels);
 }
 
 }
@@ -27,11 +27,14 @@ struct Audio {
 
   auto createStream(uint channels, double frequency) -> shared_pointer<Stream>;
 
-private:
+  //mixes every frame that all streams have ready, and sends them to the platform as one block.
+  //streams call this each time they have a few milliseconds buffered; cores call it once per video frame.
   auto process() -> void;
 
+private:
   Interface* _interface = nullptr;
   vector<shared_pointer<Stream>> _streams;
+  vector<double> _samples;  //interleaved output block
 
   uint _channels = 0;
   double _frequency = 48000.0;
@@ -65,7 +68,9 @@ struct Stream {
 
   auto pending() const -> uint;
   auto read(double samples[]) -> uint;
+  auto mix(double samples[], uint frames, uint channels) -> void;
   auto write(const double samples[]) -> void;
+  auto write(const double samples[], uint frames) -> void;
 
   template<typename... P> auto sample(P&&... p) -> void {
     double samples[sizeof...(P)] = {forward<P>(p)...};
@@ -83,6 +88,7 @@ private:
   vector<Channel> channels;
   double inputFrequency;
   double outputFrequency;
+  uint blockSize = 1;  //pending frames that trigger mixing
 
   friend class Audio;
 };
@@ -28,6 +28,9 @@ auto Stream::setFrequency(double inputFrequency, maybe<double> outputFrequency)
     channel.resampler.reset(this->inputFrequency, this->outputFrequency);
   }
 
+  //mix about every 5ms; the resampler holds up to 20ms
+  blockSize = max(1.0, this->outputFrequency * 0.005);
+
   if(this->inputFrequency >= this->outputFrequency * 2) {
     //add a low-pass filter to prevent aliasing during resampling
     double cutoffFrequency = min(25000.0, this->outputFrequency / 2.0 - 2000.0);
@@ -97,23 +100,42 @@ auto Stream::read(double samples[]) -> uint {
   return channels.size();
 }
 
+//adds frames to an interleaved block; a stream with fewer channels than the block repeats them across it
+auto Stream::mix(double samples[], uint frames, uint channelCount) -> void {
+  uint count = channels.size();
+  for(uint n : range(frames)) {
+    auto frame = samples + n * channelCount;
+    for(uint c : range(count)) {
+      double sample = channels[c].resampler.read();
+      for(uint target = c; target < channelCount; target += count) frame[target] += sample;
+    }
+  }
+}
+
 auto Stream::write(const double samples[]) -> void {
-  for(auto c : range(channels.size())) {
-    double sample = samples[c] + 1e-25;  //constant offset used to suppress denormals
-    for(auto& filter : channels[c].filters) {
-      switch(filter.mode) {
-      case Filter::Mode::DCRemoval: sample = filter.dcRemoval.process(sample); break;
-      case Filter::Mode::OnePole: sample = filter.onePole.process(sample); break;
-      case Filter::Mode::Biquad: sample = filter.biquad.process(sample); break;
+  write(samples, 1);
+}
+
+//writes interleaved frames
+auto Stream::write(const double samples[], uint frames) -> void {
+  for(uint n : range(frames)) {
+    for(auto c : range(channels.size())) {
+      double sample = samples[n * channels.size() + c] + 1e-25;  //constant offset used to suppress denormals
+      for(auto& filter : channels[c].filters) {
+        switch(filter.mode) {
+        case Filter::Mode::DCRemoval: sample = filter.dcRemoval.process(sample); break;
+        case Filter::Mode::OnePole: sample = filter.onePole.process(sample); break;
+        case Filter::Mode::Biquad: sample = filter.biquad.process(sample); break;
+        }
       }
+      for(auto& filter : channels[c].nyquist) {
+        sample = filter.process(sample);
+      }
+      channels[c].resampler.write(sample);
     }
-    for(auto& filter : channels[c].nyquist) {
-      sample = filter.process(sample);
-    }
-    channels[c].resampler.write(sample);
   }
 
-  audio.process();
+  if(pending() >= blockSize) audio.process();
 }
 
 auto Stream::serialize(serializer& s) -> void {
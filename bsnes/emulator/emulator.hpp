@@ -28,6 +28,7 @@ using namespace nall;
 #include <emulator/memory/readable.hpp>
 #include <emulator/memory/writable.hpp>
 #include <emulator/audio/audio.hpp>
+#include <emulator/netplay/netplay.hpp>
 
 // [jsd] add support for AngelScript
 #include <script/script.hpp>
@@ -259,6 +259,7 @@ namespace hiro {
     auto append(sSizable sizable) -> type& { (void)sizable; return *this; }
     auto backgroundColor() const -> Color { return {}; }
     auto dismissable() const -> bool { return false; }
+    auto doActivate() const -> void {}
     auto frameGeometry() const -> Geometry { return {}; }
     auto fullScreen() const -> bool { return false; }
     auto geometry() const -> Geometry { return {}; }
@@ -50,6 +50,14 @@ struct Interface : Script::Interface {
     string name;
   };
 
+  //host time, emulated clocks and thread switches of one component over a frame
+  struct Profile {
+    string name;
+    uint64 nanoseconds = 0;
+    uint64 clocks = 0;
+    uint64 switches = 0;  //times the component was switched to
+  };
+
   //information
   virtual auto information() -> Information { return {}; }
 
@@ -75,6 +83,7 @@ struct Interface : Script::Interface {
   virtual auto power() -> void {}
   virtual auto reset() -> void {}
   virtual auto run() -> void {}
+  virtual auto frameCount() -> uint64 { return 0; }  //frames completed by run(), including speculative ones
   virtual auto idle() -> void {}
 
   //time functions
@@ -83,7 +92,9 @@ struct Interface : Script::Interface {
 
   //state functions
   virtual auto serialize(bool synchronize = true) -> serializer { return {}; }
+  virtual auto serialize(serializer& s, uint& generation) -> bool { return false; }  //incremental
   virtual auto unserialize(serializer&) -> bool { return false; }
+  virtual auto unserialize(serializer& s, uint generation) -> bool { return false; }  //incremental
 
   //cheat functions
   virtual auto read(uint24 address) -> uint8 { return 0; }
@@ -105,6 +116,11 @@ struct Interface : Script::Interface {
 
   virtual auto runAhead() -> bool { return false; }
   virtual auto setRunAhead(bool runAhead) -> void {}
+  virtual auto setSpeculative(bool speculative) -> void {}
+
+  virtual auto profiling() -> bool { return false; }
+  virtual auto setProfiling(bool profiling) -> void {}
+  virtual auto profile() -> vector<Profile> { return {}; }  //the last completed frame
 
   //scripting
   virtual auto loadScript(string location) -> void {}
@@ -0,0 +1,319 @@
+namespace Emulator {
+
+Netplay::~Netplay() {
+  stop();
+}
+
+auto Netplay::start(Interface* interface, shared_pointer<Peer> peer, Settings settings) -> bool {
+  stop();
+  if(!interface || !peer || settings.player > 1) return false;
+
+  settings.delay = min(settings.delay, MaxDelay);
+  settings.window = max(1u, min(settings.window, MaxWindow));
+  _interface = interface;
+  _peer = peer;
+  _settings = settings;
+  _metrics = {};
+  for(auto& player : _players) player = {};
+  //both players start from the same state; the frames before the local input takes effect have no input:
+  _players[settings.player].confirmed = settings.delay;
+  _states.reset();
+  _states.resize(settings.window + 1);
+  _current[0] = _current[1] = 0;
+  _frame = 0;
+  _rollback = NoRollback;
+  return true;
+}
+
+auto Netplay::stop() -> void {
+  if(_interface) {
+    _interface->setSpeculative(false);
+    _interface->setRunAhead(false);
+  }
+  _interface = nullptr;
+  _peer.reset();
+  _states.reset();
+  _current[0] = _current[1] = 0;
+}
+
+auto Netplay::run(uint16 input) -> bool {
+  if(!_interface) return false;
+
+  receive();
+  resimulate();
+
+  //running further ahead of the remote input than can be rolled back has to wait for it:
+  auto& local = _players[_settings.player];
+  auto& remote = _players[!_settings.player];
+  if(_frame >= remote.confirmed + _settings.window) {
+    _metrics.stalls++;
+    send();
+    return false;
+  }
+
+  local.inputs[local.confirmed % History] = input;
+  local.confirmed++;
+  send();
+
+  save(_frame);
+  advance();
+  _metrics.frames++;
+  return true;
+}
+
+auto Netplay::idle() -> void {
+  if(!_interface) return;
+
+  receive();
+  resimulate();
+  send();
+}
+
+auto Netplay::confirmed() const -> uint {
+  return min(_frame, min(_players[0].confirmed, _players[1].confirmed));
+}
+
+//the remote input is predicted to repeat its last confirmed value:
+auto Netplay::predict(const Player& player, uint frame) const -> uint16 {
+  if(frame < player.confirmed) return player.inputs[frame % History];
+  if(player.confirmed == 0) return 0;
+  return player.inputs[(player.confirmed - 1) % History];
+}
+
+auto Netplay::receive() -> void {
+  auto& local = _players[_settings.player];
+  auto& remote = _players[!_settings.player];
+
+  vector<uint8_t> data;
+  Packet packet;
+  while(_peer->receive(data)) {
+    _metrics.packetsReceived++;
+    _metrics.bytesReceived += data.size();
+    if(!packet.decode(data)) continue;
+
+    local.acknowledged = max(local.acknowledged, min(packet.acknowledged, local.confirmed));
+    //inputs are only taken in order; after a gap they are dropped, and will be sent again:
+    if(packet.first > remote.confirmed) continue;
+    for(uint n = remote.confirmed - packet.first; n < packet.inputs.size(); n++) {
+      uint frame = packet.first + n;
+      //a peer that claims to be further ahead than it could be would overwrite input that is still needed:
+      if(frame >= _frame + History - MaxWindow - 1) break;
+      auto input = packet.inputs[n];
+      remote.inputs[frame % History] = input;
+      remote.confirmed = frame + 1;
+      if(frame < _frame && remote.used[frame % History] != input) _rollback = min(_rollback, frame);
+    }
+  }
+}
+
+auto Netplay::send() -> void {
+  auto& local = _players[_settings.player];
+  auto& remote = _players[!_settings.player];
+
+  Packet packet;
+  packet.first = local.acknowledged;
+  packet.acknowledged = remote.confirmed;
+  uint count = min(local.confirmed - local.acknowledged, MaxInputs);
+  for(uint frame : range(packet.first, packet.first + count)) packet.inputs.append(local.inputs[frame % History]);
+
+  auto data = packet.encode();
+  _peer->send(data);
+  _metrics.packetsSent++;
+  _metrics.bytesSent += data.size();
+}
+
+//restores the state before the first mispredicted frame, and runs the frames since again with the input now known.
+//these frames are speculative: their audio and video were already output, so only the script pre_frame() and
+//pre_nmi() hooks run again, which keeps memory patches made by scripts applied to the frames that replace them.
+auto Netplay::resimulate() -> void {
+  if(_rollback >= _frame) {
+    _rollback = NoRollback;
+    return;
+  }
+
+  auto start = chrono::nanosecond();
+  uint target = _frame;
+  uint depth = target - _rollback;
+  if(!load(_rollback)) {
+    //the state fell out of the window; this cannot happen while run() waits for the remote input
+    _rollback = NoRollback;
+    return;
+  }
+
+  _interface->setSpeculative(true);
+  _interface->setRunAhead(true);
+  _frame = _rollback;
+  while(_frame < target) {
+    if(_frame != _rollback) save(_frame);
+    advance();
+  }
+  _interface->setRunAhead(false);
+  _interface->setSpeculative(false);
+
+  _metrics.rollbacks++;
+  _metrics.resimulated += depth;
+  _metrics.maxDepth = max(_metrics.maxDepth, depth);
+  _metrics.resimulationTime += chrono::nanosecond() - start;
+  _rollback = NoRollback;
+}
+
+//states are updated in place, copying only the memory pages written since the slot was last saved:
+auto Netplay::save(uint frame) -> void {
+  auto start = chrono::nanosecond();
+  auto& state = _states[frame % _states.size()];
+  if(!_interface->serialize(state.data, state.generation)) {
+    state.data = _interface->serialize(false);
+    state.generation = 0;
+  }
+  state.frame = frame;
+  _metrics.saveTime += chrono::nanosecond() - start;
+}
+
+auto Netplay::load(uint frame) -> bool {
+  auto& state = _states[frame % _states.size()];
+  if(state.frame != frame || !state.data.capacity()) return false;
+  if(state.generation && _interface->unserialize(state.data, state.generation)) return true;
+  state.data.setMode(serializer::Mode::Load);
+  state.generation = 0;
+  return _interface->unserialize(state.data);
+}
+
+auto Netplay::advance() -> void {
+  for(uint n : range(2)) {
+    auto& player = _players[n];
+    _current[n] = predict(player, _frame);
+    player.used[_frame % History] = _current[n];
+  }
+  //run() returns at every scheduler event; the frame is complete once the core counts it:
+  for(auto frames = _interface->frameCount(); _interface->frameCount() == frames;) _interface->run();
+  _frame++;
+}
+
+auto Netplay::Packet::decode(array_view<uint8_t> data) -> bool {
+  auto read = [&](uint offset, uint bytes) -> uint {
+    uint value = 0;
+    for(uint n : range(bytes)) value |= data[offset + n] << n * 8;
+    return value;
+  };
+
+  if(data.size() < Header || read(0, 2) != Magic) return false;
+  uint count = read(10, 2);
+  if(data.size() != Header + count * 2) return false;
+  first = read(2, 4);
+  acknowledged = read(6, 4);
+  inputs.resize(count);
+  for(uint n : range(count)) inputs[n] = read(Header + n * 2, 2);
+  return true;
+}
+
+auto Netplay::Packet::encode() const -> vector<uint8_t> {
+  vector<uint8_t> data;
+  data.reserve(Header + inputs.size() * 2);
+  auto write = [&](uint value, uint bytes) {
+    for(uint n : range(bytes)) data.append(value >> n * 8);
+  };
+
+  write(Magic, 2);
+  write(first, 4);
+  write(acknowledged, 4);
+  write(inputs.size(), 2);
+  for(auto input : inputs) write(input, 2);
+  return data;
+}
+
+//
+
+Netplay::UDP::~UDP() {
+  if(fd < 0) return;
+  #if defined(PLATFORM_WINDOWS)
+  ::closesocket(fd);
+  #else
+  ::close(fd);
+  #endif
+}
+
+auto Netplay::UDP::open(uint localPort, const string& host, uint port) -> bool {
+  addrinfo hints{};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_DGRAM;
+  addrinfo* remote = nullptr;
+  if(getaddrinfo(host, string{port}, &hints, &remote) != 0 || !remote) return false;
+
+  fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in local{};
+  local.sin_family = AF_INET;
+  local.sin_addr.s_addr = htonl(INADDR_ANY);
+  local.sin_port = htons(localPort);
+  bool opened = fd >= 0
+    && ::bind(fd, (sockaddr*)&local, sizeof(local)) == 0
+    && ::connect(fd, remote->ai_addr, remote->ai_addrlen) == 0;
+  freeaddrinfo(remote);
+  if(!opened) return false;
+
+  #if defined(PLATFORM_WINDOWS)
+  u_long nonblocking = 1;
+  return ioctlsocket(fd, FIONBIO, &nonblocking) == 0;
+  #else
+  return ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK) == 0;
+  #endif
+}
+
+auto Netplay::UDP::send(array_view<uint8_t> packet) -> void {
+  if(fd < 0) return;
+  ::send(fd, (const char*)packet.data(), packet.size(), MSG_NOSIGNAL);
+}
+
+auto Netplay::UDP::receive(vector<uint8_t>& packet) -> bool {
+  if(fd < 0) return false;
+  uint8_t buffer[1500];
+  //errors, such as the port being refused while the other player has not started yet, read as no packet:
+  auto length = ::recv(fd, (char*)buffer, sizeof(buffer), 0);
+  if(length < 0) return false;
+  packet.resize(length);
+  memory::copy(packet.data(), buffer, length);
+  return true;
+}
+
+//
+
+Netplay::Loopback::Loopback(uint latency, uint loss, uint delay, uint window)
+: latency(latency), loss(min(loss, 100u)), delay(delay), window(max(1u, window)) {
+}
+
+auto Netplay::Loopback::send(array_view<uint8_t> data) -> void {
+  Packet packet;
+  if(!packet.decode(data)) return;
+  if(packet.first <= received) received = max(received, packet.first + (uint)packet.inputs.size());
+  acknowledged = max(acknowledged, packet.acknowledged);
+
+  //it waits for the local player the same way the local player waits for it:
+  if(frame < received + window) frame++;
+
+  Packet answer;
+  answer.first = acknowledged;
+  answer.acknowledged = received;
+  for(uint n = acknowledged; n < frame + delay && answer.inputs.size() < MaxInputs; n++) answer.inputs.append(input(n));
+
+  //losses are spread evenly, so that runs are reproducible:
+  ticks++;
+  if(ticks * loss / 100 != (ticks - 1) * loss / 100) return;
+  pending.append({ticks + latency, answer.encode()});
+}
+
+auto Netplay::Loopback::receive(vector<uint8_t>& packet) -> bool {
+  if(!pending || pending.first().due > ticks) return false;
+  packet = move(pending.first().packet);
+  pending.removeLeft();
+  return true;
+}
+
+//a new combination of the twelve gamepad buttons every eight frames:
+auto Netplay::Loopback::input(uint frame) -> uint16 {
+  uint32 hash = (frame / 8 + 1) * 0x9e3779b1;
+  hash ^= hash >> 15;
+  hash *= 0x85ebca6b;
+  hash ^= hash >> 13;
+  return hash & 0x0fff;
+}
+
+}
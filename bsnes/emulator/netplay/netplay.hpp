@@ -0,0 +1,148 @@
+#pragma once
+
+namespace Emulator {
+
+struct Interface;
+
+//rollback netplay between two players. each player's input is one 16-bit word per frame, which is exchanged with the
+//other player every frame. frames are run as soon as the local input is known, with the remote input predicted to
+//repeat its last confirmed value; when the confirmed value turns out to differ, the emulator is rolled back to the
+//state before that frame and the frames since are run again. frontends answer inputPoll() from input(port).
+struct Netplay {
+  //carries packets to and from the other player; neither call may block:
+  struct Peer {
+    virtual ~Peer() = default;
+    virtual auto send(array_view<uint8_t> packet) -> void = 0;
+    virtual auto receive(vector<uint8_t>& packet) -> bool = 0;  //false when no packet is waiting
+  };
+
+  //a UDP socket that exchanges packets with one remote address:
+  struct UDP : Peer {
+    ~UDP();
+    auto open(uint localPort, const string& host, uint port) -> bool;
+    auto send(array_view<uint8_t> packet) -> void override;
+    auto receive(vector<uint8_t>& packet) -> bool override;
+
+  private:
+    int fd = -1;
+  };
+
+  //a simulated remote player, for testing without a network: it advances one frame for every packet it is sent,
+  //answers each one `latency` packets later, drops `loss` percent of its answers, and plays pseudo-random input
+  //that changes every eight frames, so that predictions keep failing the way a real player's would:
+  struct Loopback : Peer {
+    Loopback(uint latency, uint loss = 0, uint delay = 2, uint window = 8);
+    auto send(array_view<uint8_t> packet) -> void override;
+    auto receive(vector<uint8_t>& packet) -> bool override;
+
+    static auto input(uint frame) -> uint16;
+
+  private:
+    struct Pending {
+      uint64 due;
+      vector<uint8_t> packet;
+    };
+
+    uint latency;
+    uint loss;
+    uint delay;
+    uint window;
+    uint64 ticks = 0;        //packets sent to it
+    uint frame = 0;          //frames it has run
+    uint received = 0;       //frames of the local player's input it has confirmed
+    uint acknowledged = 0;   //frames of its input the local player has confirmed
+    vector<Pending> pending;
+  };
+
+  struct Settings {
+    uint player = 0;  //the local player, 0 or 1; the remote player is the other
+    uint delay = 2;   //frames between sampling the local input and running it, which hides that much latency
+    uint window = 8;  //frames that may be run ahead of the remote input, and so rolled back
+  };
+
+  struct Metrics {
+    uint64 frames = 0;            //frames advanced by run()
+    uint64 stalls = 0;            //calls to run() that waited for the remote input instead
+    uint64 rollbacks = 0;
+    uint64 resimulated = 0;       //frames run again after a misprediction
+    uint   maxDepth = 0;          //most frames rolled back at once
+    uint64 resimulationTime = 0;  //nanoseconds spent restoring states and running frames again
+    uint64 saveTime = 0;          //nanoseconds spent saving the state before every frame
+    uint64 packetsSent = 0;
+    uint64 bytesSent = 0;
+    uint64 packetsReceived = 0;
+    uint64 bytesReceived = 0;
+  };
+
+  ~Netplay();
+
+  auto start(Interface* interface, shared_pointer<Peer> peer, Settings settings) -> bool;
+  auto stop() -> void;
+  explicit operator bool() const { return _interface; }
+
+  //runs the next frame with the given local input, after taking in the remote input and rolling back if it was
+  //mispredicted. returns false without running a frame while the remote player is too far behind:
+  auto run(uint16 input) -> bool;
+  //the same exchange and rollback without running a frame, for frontends that are paused or waiting:
+  auto idle() -> void;
+
+  auto input(uint player) const -> uint16 { return player < 2 ? _current[player] : 0; }
+  auto frame() const -> uint { return _frame; }            //frames run so far
+  auto confirmed() const -> uint;                          //frames run with confirmed input from both players
+  auto synchronized() const -> bool { return confirmed() == _frame; }
+  auto metrics() const -> const Metrics& { return _metrics; }
+
+private:
+  static constexpr uint History = 256;     //frames of input kept for each player
+  static constexpr uint MaxDelay = 16;
+  static constexpr uint MaxWindow = 32;
+  static constexpr uint MaxInputs = 128;   //inputs per packet; covers every input the other player can be missing
+  static constexpr uint NoRollback = ~0u;
+
+  //every packet carries the sender's inputs from the first one the receiver has not confirmed:
+  //  uint16 magic, uint32 first frame, uint32 frames of the receiver's input confirmed, uint16 count, uint16 inputs[]
+  struct Packet {
+    static constexpr uint16 Magic = 0x504e;  //"NP"
+    static constexpr uint Header = 12;
+
+    uint first = 0;
+    uint acknowledged = 0;
+    vector<uint16> inputs;
+
+    auto decode(array_view<uint8_t> data) -> bool;
+    auto encode() const -> vector<uint8_t>;
+  };
+
+  struct Player {
+    uint16 inputs[History] = {};  //confirmed input by frame
+    uint16 used[History] = {};    //input each frame was last run with
+    uint confirmed = 0;           //frames [0, confirmed) are confirmed
+    uint acknowledged = 0;        //frames [0, acknowledged) are confirmed by the other player
+  };
+
+  struct State {
+    serializer data;
+    uint generation = 0;  //for incremental saves and restores; 0 when the state must be copied in full
+    uint frame = 0;       //the state is the one before this frame was run
+  };
+
+  auto predict(const Player& player, uint frame) const -> uint16;
+  auto receive() -> void;
+  auto send() -> void;
+  auto resimulate() -> void;
+  auto save(uint frame) -> void;
+  auto load(uint frame) -> bool;
+  auto advance() -> void;
+
+  Interface* _interface = nullptr;
+  shared_pointer<Peer> _peer;
+  Settings _settings;
+  Metrics _metrics;
+  Player _players[2];
+  vector<State> _states;  //the state before each of the last window + 1 frames, by frame modulo their count
+  uint16 _current[2] = {};  //input of the frame being run
+  uint _frame = 0;
+  uint _rollback = NoRollback;  //earliest frame run with a mispredicted input
+};
+
+}
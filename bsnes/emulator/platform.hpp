@@ -22,6 +22,10 @@ struct Platform : Script::Platform {
   virtual auto load(uint id, string name, string type, vector<string> options = {}) -> Load { return {}; }
   virtual auto videoFrame(const uint16* data, uint pitch, uint width, uint height, uint scale) -> void {}
   virtual auto audioFrame(const double* samples, uint channels) -> void {}
+  //audio is delivered in blocks of interleaved frames; override this to avoid a call per frame
+  virtual auto audioFrames(const double* samples, uint frames, uint channels) -> void {
+    for(uint n : range(frames)) audioFrame(samples + n * channels, channels);
+  }
   virtual auto inputPoll(uint port, uint device, uint input) -> int16 { return 0; }
   virtual auto inputRumble(uint port, uint device, uint input, bool enable) -> void {}
   virtual auto dipSettings(Markup::Node node) -> uint { return 0; }
@@ -0,0 +1,100 @@
+namespace Filter {
+
+//renders a frame as bands of rows: the calling thread and the workers claim bands until none are left.
+//there are twice as many bands as threads, so that a slow band (eg detailed HQ2x rows) does not hold up the rest.
+struct Bands {
+  enum : uint { MinimumRows = 16 };
+
+  ~Bands() { stop(); }
+
+  auto resize(uint threads) -> void {
+    if(threads == workers.size()) return;
+    stop();
+    for(uint n : range(threads)) {
+      workers.emplace_back([this] { worker(); });
+    }
+  }
+
+  auto run(uint height, const function<void (uint top, uint bottom)>& render) -> void {
+    uint count = min<uint>((workers.size() + 1) * 2, height / MinimumRows);
+    if(count <= 1) return render(0, height);
+
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      //a worker that woke too late for the previous frame may still be looking for a band:
+      while(busy.load()) {
+        guard.unlock();
+        std::this_thread::yield();
+        guard.lock();
+      }
+      this->render = &render;
+      this->height = height;
+      this->count = count;
+      next.store(0);
+      done.store(0);
+      generation++;
+    }
+    wake.notify_all();
+
+    while(claim());
+    while(done.load() != count) std::this_thread::yield();
+  }
+
+private:
+  //claim and render one band; returns false once every band has been claimed
+  auto claim() -> bool {
+    uint band = next.fetch_add(1);
+    if(band >= count) return false;
+    (*render)(height * band / count, height * (band + 1) / count);
+    done.fetch_add(1);
+    return true;
+  }
+
+  auto worker() -> void {
+    std::unique_lock<std::mutex> guard(lock);
+    uint seen = generation;
+    while(true) {
+      wake.wait(guard, [&] { return generation != seen || quit; });
+      if(quit) return;
+      seen = generation;
+      busy.fetch_add(1);
+      guard.unlock();
+      while(claim());
+      busy.fetch_sub(1);
+      guard.lock();
+    }
+  }
+
+  auto stop() -> void {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      quit = true;
+    }
+    wake.notify_all();
+    for(auto& thread : workers) thread.join();
+    workers.clear();
+    quit = false;
+  }
+
+  //written with the lock held, while no worker is busy
+  const function<void (uint, uint)>* render = nullptr;
+  uint height = 0;
+  uint count = 0;
+  uint generation = 0;
+  bool quit = false;
+
+  std::atomic<uint> next{0};  //next band to be claimed
+  std::atomic<uint> done{0};  //bands finished rendering
+  std::atomic<uint> busy{0};  //workers claiming bands
+  std::mutex lock;
+  std::condition_variable wake;
+  std::vector<std::thread> workers;
+};
+
+static Bands bands;
+
+auto setThreads(uint threads) -> void {
+  bands.resize(threads);
+}
+
+}
@@ -1,4 +1,6 @@
 #include <emulator/emulator.hpp>
+#include <nall/simd.hpp>
+#include "filter.hpp"
 
 #undef register
 #define register
@@ -8,6 +10,9 @@ uint32_t* colortable;
 #include "snes_ntsc/snes_ntsc.h"
 #include "snes_ntsc/snes_ntsc.c"
 
+#include "vector.cpp"
+#include "bands.cpp"
+
 #include "none.cpp"
 #include "scanlines-light.cpp"
 #include "scanlines-dark.cpp"
@@ -23,3 +28,17 @@ uint32_t* colortable;
 #include "ntsc-composite.cpp"
 #include "ntsc-svideo.cpp"
 #include "ntsc-rgb.cpp"
+
+namespace Filter {
+
+auto initialize() -> void {
+  HQ2x::initialize();
+  ScanlinesLight::initialize();
+  ScanlinesDark::initialize();
+  NTSC_RF::initialize();
+  NTSC_Composite::initialize();
+  NTSC_SVideo::initialize();
+  NTSC_RGB::initialize();
+}
+
+}
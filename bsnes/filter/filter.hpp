@@ -6,6 +6,20 @@ namespace Filter {
   using Size = auto (*)(uint& width, uint& height) -> void;
   using Render = auto (*)(uint32_t* palette, uint32_t* output, uint outpitch,
     const uint16_t* input, uint pitch, uint width, uint height) -> void;
+
+  //builds the lookup tables of every filter (the NTSC ones take milliseconds each), which would otherwise be built
+  //by the first frame a filter renders. safe to call from another thread while frames are being rendered
+  auto initialize() -> void;
+
+  enum class InstructionSet : uint { Scalar, SSE2, AVX2, NEON };
+
+  //frames are split into bands of rows, rendered by this many worker threads alongside the calling one (none by default)
+  auto setThreads(uint threads) -> void;
+
+  //the instruction sets this build has kernels for, scalar first; the best one is selected by default
+  auto instructionSets() -> vector<InstructionSet>;
+  auto setInstructionSet(InstructionSet set) -> bool;
+  auto name(InstructionSet set) -> string;
 }
 
 namespace Filter::None {
@@ -28,39 +28,38 @@ const uint8_t hqTable[256] = {
 };
 
 static void initialize() {
-  static bool initialized = false;
-  if(initialized == true) return;
-  initialized = true;
-
-  yuvTable = new uint32_t[32768];
-
-  for(unsigned i = 0; i < 32768; i++) {
-    uint8_t R = (i >>  0) & 31;
-    uint8_t G = (i >>  5) & 31;
-    uint8_t B = (i >> 10) & 31;
-
-    //bgr555->bgr888
-    double r = (R << 3) | (R >> 2);
-    double g = (G << 3) | (G >> 2);
-    double b = (B << 3) | (B >> 2);
-
-    //bgr888->yuv
-    double y = (r + g + b) * (0.25f * (63.5f / 48.0f));
-    double u = ((r - b) * 0.25f + 128.0f) * (7.5f / 7.0f);
-    double v = ((g * 2.0f - r - b) * 0.125f + 128.0f) * (7.5f / 6.0f);
-
-    yuvTable[i] = ((unsigned)y << 21) + ((unsigned)u << 11) + ((unsigned)v);
-  }
+  static std::once_flag initialized;
+  std::call_once(initialized, [] {
+    yuvTable = new uint32_t[32768];
+
+    for(unsigned i = 0; i < 32768; i++) {
+      uint8_t R = (i >>  0) & 31;
+      uint8_t G = (i >>  5) & 31;
+      uint8_t B = (i >> 10) & 31;
+
+      //bgr555->bgr888
+      double r = (R << 3) | (R >> 2);
+      double g = (G << 3) | (G >> 2);
+      double b = (B << 3) | (B >> 2);
+
+      //bgr888->yuv
+      double y = (r + g + b) * (0.25f * (63.5f / 48.0f));
+      double u = ((r - b) * 0.25f + 128.0f) * (7.5f / 7.0f);
+      double v = ((g * 2.0f - r - b) * 0.125f + 128.0f) * (7.5f / 6.0f);
+
+      yuvTable[i] = ((unsigned)y << 21) + ((unsigned)u << 11) + ((unsigned)v);
+    }
 
-  //counter-clockwise rotation table; one revolution:
-  //123    369  12346789
-  //4.6 -> 2.8  =
-  //789    147  36928147
-  for(unsigned n = 0; n < 256; n++) {
-    rotate[n] = ((n >> 2) & 0x11) | ((n << 2) & 0x88)
-              | ((n & 0x01) << 5) | ((n & 0x08) << 3)
-              | ((n & 0x10) >> 3) | ((n & 0x80) >> 5);
-  }
+    //counter-clockwise rotation table; one revolution:
+    //123    369  12346789
+    //4.6 -> 2.8  =
+    //789    147  36928147
+    for(unsigned n = 0; n < 256; n++) {
+      rotate[n] = ((n >> 2) & 0x11) | ((n << 2) & 0x88)
+                | ((n & 0x01) << 5) | ((n & 0x08) << 3)
+                | ((n & 0x10) >> 3) | ((n & 0x80) >> 5);
+    }
+  });
 }
 
 static void terminate() {
@@ -138,6 +137,37 @@ auto size(uint& width, uint& height) -> void {
   height *= 2;
 }
 
+//the neighbors of each pixel are compared in YUV space a vector at a time: one pattern bit per neighbor that differs.
+//rows hold the YUV values of the rows above, at and below the pixels; the first and last pixel are left to the scalar code
+template<typename V> static auto vectorPatterns(uint8_t* patterns, const uint32_t* rows[3], uint width) -> uint {
+  constexpr uint Lanes = V::Bytes / 4;
+  auto offset = V::fill32(diff_offset);
+  auto mask = V::fill32(diff_mask);
+  auto zero = V::fill32(0);
+  uint x = 1;
+  for(; x + Lanes < width; x += Lanes) {
+    auto e = V::add32(V::load(rows[1] + x), offset);
+    auto pattern = zero;
+    auto compare = [&](const uint32_t* neighbor, uint bit) {
+      auto difference = V::mask(V::sub32(e, V::load(neighbor)), mask);
+      pattern = V::merge(pattern, V::clear(V::equal32(difference, zero), V::fill32(1 << bit)));
+    };
+    compare(rows[0] + x - 1, 0);
+    compare(rows[0] + x + 0, 1);
+    compare(rows[0] + x + 1, 2);
+    compare(rows[1] + x - 1, 3);
+    compare(rows[1] + x + 1, 4);
+    compare(rows[2] + x - 1, 5);
+    compare(rows[2] + x + 0, 6);
+    compare(rows[2] + x + 1, 7);
+
+    uint32_t lanes[Lanes];
+    V::store(lanes, pattern);
+    for(uint n : range(Lanes)) patterns[x + n] = lanes[n];
+  }
+  return x;
+}
+
 auto render(
   uint32_t* colortable, uint32_t* output, uint outpitch,
   const uint16_t* input, uint pitch, uint width, uint height
@@ -147,54 +177,97 @@ auto render(
   pitch    >>= 1;
   outpitch >>= 2;
 
-  for(uint y = 0; y < height; y++) {
-    const uint16_t* in = input + y * pitch;
-    uint32_t* out0 = output + y * outpitch * 2;
-    uint32_t* out1 = output + y * outpitch * 2 + outpitch;
-
-    int prevline = (y == 0 ? 0 : pitch);
-    int nextline = (y == height - 1 ? 0 : pitch);
-
-    in++;
-    *out0++ = 0; *out0++ = 0;
-    *out1++ = 0; *out1++ = 0;
-
-    for(unsigned x = 1; x < width - 1; x++) {
-      uint16_t A = *(in - prevline - 1);
-      uint16_t B = *(in - prevline + 0);
-      uint16_t C = *(in - prevline + 1);
-      uint16_t D = *(in - 1);
-      uint16_t E = *(in + 0);
-      uint16_t F = *(in + 1);
-      uint16_t G = *(in + nextline - 1);
-      uint16_t H = *(in + nextline + 0);
-      uint16_t I = *(in + nextline + 1);
-      uint32_t e = yuvTable[E] + diff_offset;
-
-      uint8_t pattern;
-      pattern  = diff(e, A) << 0;
-      pattern |= diff(e, B) << 1;
-      pattern |= diff(e, C) << 2;
-      pattern |= diff(e, D) << 3;
-      pattern |= diff(e, F) << 4;
-      pattern |= diff(e, G) << 5;
-      pattern |= diff(e, H) << 6;
-      pattern |= diff(e, I) << 7;
-
-      *(out0 + 0) = colortable[blend(hqTable[pattern], E, A, B, D, F, H)]; pattern = rotate[pattern];
-      *(out0 + 1) = colortable[blend(hqTable[pattern], E, C, F, B, H, D)]; pattern = rotate[pattern];
-      *(out1 + 1) = colortable[blend(hqTable[pattern], E, I, H, F, D, B)]; pattern = rotate[pattern];
-      *(out1 + 0) = colortable[blend(hqTable[pattern], E, G, D, H, B, F)];
+  bands.run(height, [&](uint top, uint bottom) {
+    //the YUV values of three consecutive rows, reused as the band moves down (vectors only)
+    uint32_t yuv[3][512];
+    const uint32_t* rows[3] = {};
+    auto convert = [&](uint32_t* target, uint y) {
+      const uint16_t* in = input + y * pitch;
+      for(uint x = 0; x < width; x++) target[x] = yuvTable[in[x]];
+      return target;
+    };
+
+    for(uint y = top; y < bottom; y++) {
+      const uint16_t* in = input + y * pitch;
+      uint32_t* out0 = output + y * outpitch * 2;
+      uint32_t* out1 = output + y * outpitch * 2 + outpitch;
+
+      int prevline = (y == 0 ? 0 : pitch);
+      int nextline = (y == height - 1 ? 0 : pitch);
+
+      uint8_t patterns[512];
+      bool vectorized = false;
+      if(width <= 512) vectorize([&](auto V) {
+        if(y == top) {
+          rows[0] = convert(yuv[(y + 2) % 3], y == 0 ? y : y - 1);
+          rows[1] = convert(yuv[(y + 0) % 3], y);
+        } else {
+          rows[0] = rows[1];
+          rows[1] = rows[2];
+        }
+        rows[2] = y == height - 1 ? rows[1] : convert(yuv[(y + 1) % 3], y + 1);
+
+        for(uint x = vectorPatterns<decltype(V)>(patterns, rows, width); x < width - 1; x++) {
+          uint32_t e = rows[1][x] + diff_offset;
+          uint8_t pattern;
+          pattern  = (bool)((e - rows[0][x - 1]) & diff_mask) << 0;
+          pattern |= (bool)((e - rows[0][x + 0]) & diff_mask) << 1;
+          pattern |= (bool)((e - rows[0][x + 1]) & diff_mask) << 2;
+          pattern |= (bool)((e - rows[1][x - 1]) & diff_mask) << 3;
+          pattern |= (bool)((e - rows[1][x + 1]) & diff_mask) << 4;
+          pattern |= (bool)((e - rows[2][x - 1]) & diff_mask) << 5;
+          pattern |= (bool)((e - rows[2][x + 0]) & diff_mask) << 6;
+          pattern |= (bool)((e - rows[2][x + 1]) & diff_mask) << 7;
+          patterns[x] = pattern;
+        }
+        vectorized = true;
+      }, [] {});
 
       in++;
-      out0 += 2;
-      out1 += 2;
-    }
+      *out0++ = 0; *out0++ = 0;
+      *out1++ = 0; *out1++ = 0;
+
+      for(unsigned x = 1; x < width - 1; x++) {
+        uint16_t A = *(in - prevline - 1);
+        uint16_t B = *(in - prevline + 0);
+        uint16_t C = *(in - prevline + 1);
+        uint16_t D = *(in - 1);
+        uint16_t E = *(in + 0);
+        uint16_t F = *(in + 1);
+        uint16_t G = *(in + nextline - 1);
+        uint16_t H = *(in + nextline + 0);
+        uint16_t I = *(in + nextline + 1);
+
+        uint8_t pattern;
+        if(vectorized) {
+          pattern = patterns[x];
+        } else {
+          uint32_t e = yuvTable[E] + diff_offset;
+          pattern  = diff(e, A) << 0;
+          pattern |= diff(e, B) << 1;
+          pattern |= diff(e, C) << 2;
+          pattern |= diff(e, D) << 3;
+          pattern |= diff(e, F) << 4;
+          pattern |= diff(e, G) << 5;
+          pattern |= diff(e, H) << 6;
+          pattern |= diff(e, I) << 7;
+        }
+
+        *(out0 + 0) = colortable[blend(hqTable[pattern], E, A, B, D, F, H)]; pattern = rotate[pattern];
+        *(out0 + 1) = colortable[blend(hqTable[pattern], E, C, F, B, H, D)]; pattern = rotate[pattern];
+        *(out1 + 1) = colortable[blend(hqTable[pattern], E, I, H, F, D, B)]; pattern = rotate[pattern];
+        *(out1 + 0) = colortable[blend(hqTable[pattern], E, G, D, H, B, F)];
+
+        in++;
+        out0 += 2;
+        out1 += 2;
+      }
 
-    in++;
-    *out0++ = 0; *out0++ = 0;
-    *out1++ = 0; *out1++ = 0;
-  }
+      in++;
+      *out0++ = 0; *out0++ = 0;
+      *out1++ = 0; *out1++ = 0;
+    }
+  });
 }
 
 }
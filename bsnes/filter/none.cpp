@@ -12,13 +12,11 @@ auto render(
   pitch    >>= 1;
   outpitch >>= 2;
 
-  for(uint y = 0; y < height; y++) {
-    const uint16_t* in = input + y * pitch;
-    uint32_t* out = output + y * outpitch;
-    for(uint x = 0; x < width; x++) {
-      *out++ = colortable[*in++];
+  bands.run(height, [&](uint top, uint bottom) {
+    for(uint y = top; y < bottom; y++) {
+      expand(colortable, output + y * outpitch, input + y * pitch, width);
     }
-  }
+  });
 }
 
 }
@@ -6,17 +6,16 @@ int burst;
 int burst_toggle;
 
 void initialize() {
-  static bool initialized = false;
-  if(initialized == true) return;
-  initialized = true;
-
-  ntsc = (snes_ntsc_t*)malloc(sizeof *ntsc);
-  setup = snes_ntsc_svideo;
-  setup.merge_fields = 1;
-  snes_ntsc_init(ntsc, &setup);
-
-  burst = 0;
-  burst_toggle = (setup.merge_fields ? 0 : 1);
+  static std::once_flag initialized;
+  std::call_once(initialized, [] {
+    ntsc = (snes_ntsc_t*)malloc(sizeof *ntsc);
+    setup = snes_ntsc_svideo;
+    setup.merge_fields = 1;
+    snes_ntsc_init(ntsc, &setup);
+
+    burst = 0;
+    burst_toggle = (setup.merge_fields ? 0 : 1);
+  });
 }
 
 void terminate() {
@@ -38,11 +37,15 @@ auto render(
   pitch    >>= 1;
   outpitch >>= 2;
 
-  if(width <= 256) {
-    snes_ntsc_blit      (ntsc, input, pitch, burst, width, height, output, outpitch << 2);
-  } else {
-    snes_ntsc_blit_hires(ntsc, input, pitch, burst, width, height, output, outpitch << 2);
-  }
+  //rows are independent, apart from the burst phase advancing by one each row
+  bands.run(height, [&](uint top, uint bottom) {
+    int phase = (burst + top) % snes_ntsc_burst_count;
+    if(width <= 256) {
+      snes_ntsc_blit      (ntsc, input + top * pitch, pitch, phase, width, bottom - top, output + top * outpitch, outpitch << 2);
+    } else {
+      snes_ntsc_blit_hires(ntsc, input + top * pitch, pitch, phase, width, bottom - top, output + top * outpitch, outpitch << 2);
+    }
+  });
 
   burst ^= burst_toggle;
 }
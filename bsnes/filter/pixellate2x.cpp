@@ -12,29 +12,24 @@ auto render(
   pitch >>= 1;
   outpitch >>= 2;
 
-  uint32_t *out0 = output;
-  uint32_t *out1 = output + outpitch;
-
-  for(unsigned y = 0; y < height; y++) {
-    for(unsigned x = 0; x < width; x++) {
-      uint32_t p = colortable[*input++];
-
-      *out0++ = p;
-      if(height <= 240) *out1++ = p;
-      if(width > 256) continue;
-
-      *out0++ = p;
-      if(height <= 240) *out1++ = p;
-    }
-
-    input += pitch - width;
-    if(height <= 240) {
-      out0 += outpitch + outpitch - 512;
-      out1 += outpitch + outpitch - 512;
-    } else {
-      out0 += outpitch - 512;
+  bands.run(height, [&](uint top, uint bottom) {
+    for(uint y = top; y < bottom; y++) {
+      const uint16_t* in = input + y * pitch;
+      uint32_t *out0 = output + y * outpitch * (height <= 240 ? 2 : 1);
+      uint32_t *out1 = out0 + outpitch;
+
+      for(uint x = 0; x < width; x++) {
+        uint32_t p = colortable[*in++];
+
+        *out0++ = p;
+        if(height <= 240) *out1++ = p;
+        if(width > 256) continue;
+
+        *out0++ = p;
+        if(height <= 240) *out1++ = p;
+      }
     }
-  }
+  });
 }
 
 }
@@ -5,6 +5,36 @@ auto size(uint& width, uint& height) -> void {
   height *= 2;
 }
 
+//a vector of pixels at a time; the first and last pixel of a row are left to the scalar code
+template<typename V> static auto vectorRow(
+  uint16_t* row0, uint16_t* row1, const uint16_t* in, const uint16_t* above, const uint16_t* below, uint width
+) -> uint {
+  constexpr uint Lanes = V::Bytes / 2;
+  auto ones = V::fill16(0xffff);
+  uint x = 1;
+  for(; x + Lanes < width; x += Lanes) {
+    auto A = V::load(above + x);
+    auto B = V::load(in + x - 1);
+    auto C = V::load(in + x);
+    auto D = V::load(in + x + 1);
+    auto E = V::load(below + x);
+    auto edge = V::clear(V::equal16(A, E), V::clear(V::equal16(B, D), ones));
+
+    typename V::v lo, hi;
+    V::zip16(
+      V::select(V::mask(edge, V::equal16(A, B)), A, C),
+      V::select(V::mask(edge, V::equal16(A, D)), A, C), lo, hi);
+    V::store(row0 + x * 2, lo);
+    V::store(row0 + x * 2 + Lanes, hi);
+    V::zip16(
+      V::select(V::mask(edge, V::equal16(E, B)), E, C),
+      V::select(V::mask(edge, V::equal16(E, D)), E, C), lo, hi);
+    V::store(row1 + x * 2, lo);
+    V::store(row1 + x * 2 + Lanes, hi);
+  }
+  return x;
+}
+
 auto render(
   uint32_t* colortable, uint32_t* output, uint outpitch,
   const uint16_t* input, uint pitch, uint width, uint height
@@ -12,35 +42,64 @@ auto render(
   pitch    >>= 1;
   outpitch >>= 2;
 
-  for(uint y = 0; y < height; y++) {
-    const uint16_t* in = input + y * pitch;
-    uint32_t* out0 = output + y * outpitch * 2;
-    uint32_t* out1 = output + y * outpitch * 2 + outpitch;
-
-    int prevline = (y == 0 ? 0 : pitch);
-    int nextline = (y == height - 1 ? 0 : pitch);
-
-    for(unsigned x = 0; x < width; x++) {
-      uint16_t A = *(in - prevline);
-      uint16_t B = (x > 0) ? *(in - 1) : *in;
-      uint16_t C = *in;
-      uint16_t D = (x < width - 1) ? *(in + 1) : *in;
-      uint16_t E = *(in++ + nextline);
-      uint32_t c = colortable[C];
-
-      if(A != E && B != D) {
-        *out0++ = (A == B ? colortable[A] : c);
-        *out0++ = (A == D ? colortable[A] : c);
-        *out1++ = (E == B ? colortable[E] : c);
-        *out1++ = (E == D ? colortable[E] : c);
-      } else {
-        *out0++ = c;
-        *out0++ = c;
-        *out1++ = c;
-        *out1++ = c;
-      }
+  bands.run(height, [&](uint top, uint bottom) {
+    for(uint y = top; y < bottom; y++) {
+      const uint16_t* in = input + y * pitch;
+      uint32_t* out0 = output + y * outpitch * 2;
+      uint32_t* out1 = output + y * outpitch * 2 + outpitch;
+
+      int prevline = (y == 0 ? 0 : pitch);
+      int nextline = (y == height - 1 ? 0 : pitch);
+
+      auto scalar = [&] {
+        for(unsigned x = 0; x < width; x++) {
+          uint16_t A = *(in - prevline);
+          uint16_t B = (x > 0) ? *(in - 1) : *in;
+          uint16_t C = *in;
+          uint16_t D = (x < width - 1) ? *(in + 1) : *in;
+          uint16_t E = *(in++ + nextline);
+          uint32_t c = colortable[C];
+
+          if(A != E && B != D) {
+            *out0++ = (A == B ? colortable[A] : c);
+            *out0++ = (A == D ? colortable[A] : c);
+            *out1++ = (E == B ? colortable[E] : c);
+            *out1++ = (E == D ? colortable[E] : c);
+          } else {
+            *out0++ = c;
+            *out0++ = c;
+            *out1++ = c;
+            *out1++ = c;
+          }
+        }
+      };
+
+      //vectors choose the palette index of each output pixel, which is then looked up a row at a time
+      vectorize([&](auto V) {
+        uint16_t row0[1024], row1[1024];
+        if(width > 512) return scalar();
+
+        const uint16_t* above = in - prevline;
+        const uint16_t* below = in + nextline;
+        auto pixel = [&](uint x) {
+          uint16_t A = above[x];
+          uint16_t B = in[x > 0 ? x - 1 : x];
+          uint16_t C = in[x];
+          uint16_t D = in[x < width - 1 ? x + 1 : x];
+          uint16_t E = below[x];
+          bool edge = A != E && B != D;
+          row0[x * 2 + 0] = edge && A == B ? A : C;
+          row0[x * 2 + 1] = edge && A == D ? A : C;
+          row1[x * 2 + 0] = edge && E == B ? E : C;
+          row1[x * 2 + 1] = edge && E == D ? E : C;
+        };
+        pixel(0);
+        for(uint x = vectorRow<decltype(V)>(row0, row1, in, above, below, width); x < width; x++) pixel(x);
+        decltype(V)::expand(colortable, out0, row0, width * 2);
+        decltype(V)::expand(colortable, out1, row1, width * 2);
+      }, scalar);
     }
-  }
+  });
 }
 
 }
@@ -12,17 +12,16 @@ auto render(
   pitch    >>= 1;
   outpitch >>= 2;
 
-  for(unsigned y = 0; y < height; y++) {
-    const uint16_t *in = input + y * pitch;
-    uint32_t *out0 = output + y * outpitch * 2;
-    uint32_t *out1 = output + y * outpitch * 2 + outpitch;
+  bands.run(height, [&](uint top, uint bottom) {
+    for(uint y = top; y < bottom; y++) {
+      const uint16_t *in = input + y * pitch;
+      uint32_t *out0 = output + y * outpitch * 2;
+      uint32_t *out1 = output + y * outpitch * 2 + outpitch;
 
-    for(unsigned x = 0; x < width; x++) {
-      uint16_t color = *in++;
-      *out0++ = palette[color];
-      *out1++ = 0;
+      expand(palette, out0, in, width);
+      memory::fill<uint32_t>(out1, width);
     }
-  }
+  });
 }
 
 }
@@ -3,19 +3,18 @@ namespace Filter::ScanlinesDark {
 uint16_t adjust[32768];
 
 void initialize() {
-  static bool initialized = false;
-  if(initialized == true) return;
-  initialized = true;
-
-  for(unsigned i = 0; i < 32768; i++) {
-    uint8_t r = (i >> 10) & 31;
-    uint8_t g = (i >>  5) & 31;
-    uint8_t b = (i >>  0) & 31;
-    r *= 0.333;
-    g *= 0.333;
-    b *= 0.333;
-    adjust[i] = (r << 10) + (g << 5) + (b << 0);
-  }
+  static std::once_flag initialized;
+  std::call_once(initialized, [] {
+    for(unsigned i = 0; i < 32768; i++) {
+      uint8_t r = (i >> 10) & 31;
+      uint8_t g = (i >>  5) & 31;
+      uint8_t b = (i >>  0) & 31;
+      r *= 0.333;
+      g *= 0.333;
+      b *= 0.333;
+      adjust[i] = (r << 10) + (g << 5) + (b << 0);
+    }
+  });
 }
 
 auto size(uint& width, uint& height) -> void {
@@ -32,17 +31,34 @@ auto render(
   pitch    >>= 1;
   outpitch >>= 2;
 
-  for(unsigned y = 0; y < height; y++) {
-    const uint16_t *in = input + y * pitch;
-    uint32_t *out0 = output + y * outpitch * 2;
-    uint32_t *out1 = output + y * outpitch * 2 + outpitch;
+  bands.run(height, [&](uint top, uint bottom) {
+    for(uint y = top; y < bottom; y++) {
+      const uint16_t *in = input + y * pitch;
+      uint32_t *out0 = output + y * outpitch * 2;
+      uint32_t *out1 = output + y * outpitch * 2 + outpitch;
+
+      auto scalar = [&] {
+        for(uint x = 0; x < width; x++) {
+          uint16_t color = in[x];
+          out0[x] = palette[color];
+          out1[x] = palette[adjust[color]];
+        }
+      };
 
-    for(unsigned x = 0; x < width; x++) {
-      uint16_t color = *in++;
-      *out0++ = palette[color];
-      *out1++ = palette[adjust[color]];
+      //with a gather, computing the adjustment is faster than looking it up:
+      //(c * 21) >> 6 rounds every 5-bit channel c down to the same value as c * 0.333 does
+      vectorize([&](auto V) {
+        if constexpr(!decltype(V)::Gather) return scalar();
+        uint16_t dimmed[256];
+        for(uint x = 0; x < width; x += 256) {
+          uint length = min(256u, width - x);
+          dim<21, 6>(V, dimmed, in + x, length);
+          decltype(V)::expand(palette, out0 + x, in + x, length);
+          decltype(V)::expand(palette, out1 + x, dimmed, length);
+        }
+      }, scalar);
     }
-  }
+  });
 }
 
 }
@@ -0,0 +1,214 @@
+namespace Filter {
+
+//thin wrappers over the vector extension of each instruction set, so that a kernel is written once.
+//lanes are either 16-bit (pixels) or 32-bit (YUV values); comparisons yield all-ones lanes when true.
+
+//output[n] = palette[input[n]], a pixel at a time
+static auto expandPixels(const uint32_t* palette, uint32_t* output, const uint16_t* input, uint count) -> void {
+  while(count--) *output++ = palette[*input++];
+}
+
+#if defined(SIMD_SSE2)
+struct SSE2 {
+  using v = __m128i;
+  static constexpr uint Bytes = 16;
+  static constexpr bool Gather = false;
+
+  static auto load(const void* p) -> v { return _mm_loadu_si128((const v*)p); }
+  static auto store(void* p, v a) -> void { _mm_storeu_si128((v*)p, a); }
+  static auto fill16(uint16_t n) -> v { return _mm_set1_epi16(n); }
+  static auto fill32(uint32_t n) -> v { return _mm_set1_epi32(n); }
+
+  static auto mask(v a, v b) -> v { return _mm_and_si128(a, b); }
+  static auto merge(v a, v b) -> v { return _mm_or_si128(a, b); }
+  static auto clear(v m, v a) -> v { return _mm_andnot_si128(m, a); }  //a & ~m
+  static auto select(v m, v a, v b) -> v { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+
+  static auto equal16(v a, v b) -> v { return _mm_cmpeq_epi16(a, b); }
+  static auto equal32(v a, v b) -> v { return _mm_cmpeq_epi32(a, b); }
+  static auto add16(v a, v b) -> v { return _mm_add_epi16(a, b); }
+  static auto sub16(v a, v b) -> v { return _mm_sub_epi16(a, b); }
+  static auto mul16(v a, v b) -> v { return _mm_mullo_epi16(a, b); }
+  static auto add32(v a, v b) -> v { return _mm_add_epi32(a, b); }
+  static auto sub32(v a, v b) -> v { return _mm_sub_epi32(a, b); }
+  template<int n> static auto shl16(v a) -> v { return _mm_slli_epi16(a, n); }
+  template<int n> static auto shr16(v a) -> v { return _mm_srli_epi16(a, n); }
+
+  //interleaves the 16-bit lanes of a and b: lo = a0 b0 a1 b1 ..., hi continues where lo ends
+  static auto zip16(v a, v b, v& lo, v& hi) -> void {
+    lo = _mm_unpacklo_epi16(a, b);
+    hi = _mm_unpackhi_epi16(a, b);
+  }
+
+  //there is no gather before AVX2
+  static auto expand(const uint32_t* palette, uint32_t* output, const uint16_t* input, uint count) -> void {
+    expandPixels(palette, output, input, count);
+  }
+};
+#endif
+
+#if defined(SIMD_AVX2)
+struct AVX2 {
+  using v = __m256i;
+  static constexpr uint Bytes = 32;
+  static constexpr bool Gather = true;
+
+  static auto load(const void* p) -> v { return _mm256_loadu_si256((const v*)p); }
+  static auto store(void* p, v a) -> void { _mm256_storeu_si256((v*)p, a); }
+  static auto fill16(uint16_t n) -> v { return _mm256_set1_epi16(n); }
+  static auto fill32(uint32_t n) -> v { return _mm256_set1_epi32(n); }
+
+  static auto mask(v a, v b) -> v { return _mm256_and_si256(a, b); }
+  static auto merge(v a, v b) -> v { return _mm256_or_si256(a, b); }
+  static auto clear(v m, v a) -> v { return _mm256_andnot_si256(m, a); }
+  static auto select(v m, v a, v b) -> v { return _mm256_blendv_epi8(b, a, m); }
+
+  static auto equal16(v a, v b) -> v { return _mm256_cmpeq_epi16(a, b); }
+  static auto equal32(v a, v b) -> v { return _mm256_cmpeq_epi32(a, b); }
+  static auto add16(v a, v b) -> v { return _mm256_add_epi16(a, b); }
+  static auto sub16(v a, v b) -> v { return _mm256_sub_epi16(a, b); }
+  static auto mul16(v a, v b) -> v { return _mm256_mullo_epi16(a, b); }
+  static auto add32(v a, v b) -> v { return _mm256_add_epi32(a, b); }
+  static auto sub32(v a, v b) -> v { return _mm256_sub_epi32(a, b); }
+  template<int n> static auto shl16(v a) -> v { return _mm256_slli_epi16(a, n); }
+  template<int n> static auto shr16(v a) -> v { return _mm256_srli_epi16(a, n); }
+
+  //unpack works within each 128-bit half, so the halves are put back in order afterward
+  static auto zip16(v a, v b, v& lo, v& hi) -> void {
+    v l = _mm256_unpacklo_epi16(a, b);
+    v h = _mm256_unpackhi_epi16(a, b);
+    lo = _mm256_permute2x128_si256(l, h, 0x20);
+    hi = _mm256_permute2x128_si256(l, h, 0x31);
+  }
+
+  static auto expand(const uint32_t* palette, uint32_t* output, const uint16_t* input, uint count) -> void {
+    for(; count >= 8; count -= 8, input += 8, output += 8) {
+      auto index = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)input));
+      _mm256_storeu_si256((v*)output, _mm256_i32gather_epi32((const int*)palette, index, 4));
+    }
+    expandPixels(palette, output, input, count);
+  }
+};
+#endif
+
+#if defined(SIMD_NEON)
+struct NEON {
+  using v = uint16x8_t;
+  static constexpr uint Bytes = 16;
+  static constexpr bool Gather = false;
+
+  static auto load(const void* p) -> v { return vld1q_u16((const uint16_t*)p); }
+  static auto store(void* p, v a) -> void { vst1q_u16((uint16_t*)p, a); }
+  static auto fill16(uint16_t n) -> v { return vdupq_n_u16(n); }
+  static auto fill32(uint32_t n) -> v { return vreinterpretq_u16_u32(vdupq_n_u32(n)); }
+
+  static auto mask(v a, v b) -> v { return vandq_u16(a, b); }
+  static auto merge(v a, v b) -> v { return vorrq_u16(a, b); }
+  static auto clear(v m, v a) -> v { return vbicq_u16(a, m); }
+  static auto select(v m, v a, v b) -> v { return vbslq_u16(m, a, b); }
+
+  static auto equal16(v a, v b) -> v { return vceqq_u16(a, b); }
+  static auto equal32(v a, v b) -> v { return vreinterpretq_u16_u32(vceqq_u32(vreinterpretq_u32_u16(a), vreinterpretq_u32_u16(b))); }
+  static auto add16(v a, v b) -> v { return vaddq_u16(a, b); }
+  static auto sub16(v a, v b) -> v { return vsubq_u16(a, b); }
+  static auto mul16(v a, v b) -> v { return vmulq_u16(a, b); }
+  static auto add32(v a, v b) -> v { return vreinterpretq_u16_u32(vaddq_u32(vreinterpretq_u32_u16(a), vreinterpretq_u32_u16(b))); }
+  static auto sub32(v a, v b) -> v { return vreinterpretq_u16_u32(vsubq_u32(vreinterpretq_u32_u16(a), vreinterpretq_u32_u16(b))); }
+  template<int n> static auto shl16(v a) -> v { return vshlq_n_u16(a, n); }
+  template<int n> static auto shr16(v a) -> v { return vshrq_n_u16(a, n); }
+
+  static auto zip16(v a, v b, v& lo, v& hi) -> void {
+    lo = vzip1q_u16(a, b);
+    hi = vzip2q_u16(a, b);
+  }
+
+  static auto expand(const uint32_t* palette, uint32_t* output, const uint16_t* input, uint count) -> void {
+    expandPixels(palette, output, input, count);
+  }
+};
+#endif
+
+static const string InstructionSetNames[] = {"scalar", "sse2", "avx2", "neon"};
+
+#if defined(SIMD_AVX2)
+static InstructionSet instructionSet = InstructionSet::AVX2;
+#elif defined(SIMD_SSE2)
+static InstructionSet instructionSet = InstructionSet::SSE2;
+#elif defined(SIMD_NEON)
+static InstructionSet instructionSet = InstructionSet::NEON;
+#else
+static InstructionSet instructionSet = InstructionSet::Scalar;
+#endif
+
+auto instructionSets() -> vector<InstructionSet> {
+  vector<InstructionSet> sets{InstructionSet::Scalar};
+  #if defined(SIMD_SSE2)
+  sets.append(InstructionSet::SSE2);
+  #endif
+  #if defined(SIMD_AVX2)
+  sets.append(InstructionSet::AVX2);
+  #endif
+  #if defined(SIMD_NEON)
+  sets.append(InstructionSet::NEON);
+  #endif
+  return sets;
+}
+
+auto setInstructionSet(InstructionSet set) -> bool {
+  if(!instructionSets().find(set)) return false;
+  instructionSet = set;
+  return true;
+}
+
+auto name(InstructionSet set) -> string {
+  return InstructionSetNames[(uint)set];
+}
+
+//calls vector(V{}) with the wrapper of the selected instruction set, or scalar() when vectors are not used
+template<typename Vector, typename Scalar> static auto vectorize(const Vector& vector, const Scalar& scalar) -> void {
+  switch(instructionSet) {
+  #if defined(SIMD_AVX2)
+  case InstructionSet::AVX2: return vector(AVX2{});
+  #endif
+  #if defined(SIMD_SSE2)
+  case InstructionSet::SSE2: return vector(SSE2{});
+  #endif
+  #if defined(SIMD_NEON)
+  case InstructionSet::NEON: return vector(NEON{});
+  #endif
+  default: return scalar();
+  }
+}
+
+//scales each 5-bit channel of BGR555 pixels by multiplier / 2^shift, rounding down
+template<uint multiplier, int shift, typename V> static auto dim(V, uint16_t* output, const uint16_t* input, uint count) -> void {
+  constexpr uint Lanes = V::Bytes / 2;
+  auto channel = V::fill16(31);
+  auto scale = V::fill16(multiplier);
+  uint x = 0;
+  for(; x + Lanes <= count; x += Lanes) {
+    auto p = V::load(input + x);
+    auto b = V::template shr16<shift>(V::mul16(V::mask(p, channel), scale));
+    auto g = V::template shr16<shift>(V::mul16(V::mask(V::template shr16<5>(p), channel), scale));
+    auto r = V::template shr16<shift>(V::mul16(V::mask(V::template shr16<10>(p), channel), scale));
+    V::store(output + x, V::merge(V::merge(V::template shl16<10>(r), V::template shl16<5>(g)), b));
+  }
+  for(; x < count; x++) {
+    uint p = input[x];
+    uint b = (p >>  0 & 31) * multiplier >> shift;
+    uint g = (p >>  5 & 31) * multiplier >> shift;
+    uint r = (p >> 10 & 31) * multiplier >> shift;
+    output[x] = r << 10 | g << 5 | b << 0;
+  }
+}
+
+//output[n] = palette[input[n]]
+static auto expand(const uint32_t* palette, uint32_t* output, const uint16_t* input, uint count) -> void {
+  vectorize([&](auto V) {
+    decltype(V)::expand(palette, output, input, count);
+  }, [&] {
+    expandPixels(palette, output, input, count);
+  });
+}
+
+}
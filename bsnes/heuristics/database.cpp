@@ -0,0 +1,168 @@
+namespace Heuristics {
+
+//cheap enough to call before every lookup: only stats the database unless it was replaced
+auto Database::open(const string& location) -> bool {
+  auto size = file::size(location);
+  auto time = inode::timestamp(location, inode::time::modify);
+  if(location == this->location && size == sourceSize && time == sourceTime && slots) return true;
+
+  close();
+  if(!file::exists(location) || !source.open(location, file_map::mode::read)) return false;
+  this->location = location;
+  sourceSize = size;
+  sourceTime = time;
+
+  string indexLocation = {Location::notsuffix(location), ".idx"};
+  if(mapped.open(indexLocation, file_map::mode::read) && fresh(mapped.data(), mapped.size())) {
+    slots = mapped.data() + HeaderSize;
+  } else {
+    mapped.close();
+    built = build();
+    //write to a temporary file first, so that concurrent readers never map a partial index
+    string temporary = {indexLocation, ".", hex(chrono::nanosecond())};
+    if(file::write(temporary, built) && file::move(temporary, indexLocation)
+    && mapped.open(indexLocation, file_map::mode::read) && fresh(mapped.data(), mapped.size())) {
+      built.reset();
+      slots = mapped.data() + HeaderSize;
+    } else {
+      file::remove(temporary);
+      slots = built.data() + HeaderSize;
+    }
+  }
+
+  auto header = slots - HeaderSize;
+  capacity = memory::readl<4>(header + 24);
+  count = memory::readl<4>(header + 28);
+  return true;
+}
+
+auto Database::close() -> void {
+  location = {};
+  sourceSize = 0;
+  sourceTime = 0;
+  source.close();
+  mapped.close();
+  built.reset();
+  slots = nullptr;
+  capacity = 0;
+  count = 0;
+}
+
+//returns the top-level node (eg game or cartridge) whose sha256 matches, or an empty node
+auto Database::find(const string& sha256) -> Markup::Node {
+  uint8_t hash[32];
+  if(!slots || sha256.size() != 64 || !decode(sha256.data(), hash)) return {};
+
+  for(uint n = memory::readl<4>(hash) & capacity - 1;; n = n + 1 & capacity - 1) {
+    auto slot = slots + n * SlotSize;
+    uint32_t offset = memory::readl<4>(slot + 32);
+    uint32_t length = memory::readl<4>(slot + 36);
+    if(!length) return {};
+    if(memory::compare(slot, hash, 32)) continue;
+    if((uint64_t)offset + length > source.size()) return {};
+    auto document = BML::unserialize(string{string_view{(const char*)source.data() + offset, length}});
+    for(auto node : document) return node;
+    return {};
+  }
+}
+
+auto Database::fresh(const uint8_t* data, uint64_t size) const -> bool {
+  if(size < HeaderSize || memory::compare(data, "BMLX", 4)) return false;
+  if(memory::readl<4>(data + 4) != Version) return false;
+  if(memory::readl<8>(data + 8) != sourceSize) return false;
+  if(memory::readl<8>(data + 16) != sourceTime) return false;
+  uint32_t capacity = memory::readl<4>(data + 24);
+  if(!capacity || capacity & capacity - 1) return false;
+  return size == HeaderSize + (uint64_t)capacity * SlotSize;
+}
+
+//a node starts on a line without indentation, and ends where the next unindented line (node or comment) begins
+auto Database::build() -> vector<uint8_t> {
+  struct Entry {
+    uint8_t hash[32];
+    uint32_t offset;
+    uint32_t length;
+  };
+  vector<Entry> entries;
+
+  auto text = (const char*)source.data();
+  uint64_t size = source.size();
+  maybe<uint64_t> start;
+  auto finish = [&](uint64_t end) {
+    if(!start) return;
+    //the first sha256 field within the node identifies it
+    for(uint64_t p = *start; p + 6 < end; p++) {
+      if(memory::compare(text + p, "sha256", 6)) continue;
+      p += 6;
+      while(p < end && (text[p] == ':' || text[p] == '=' || text[p] == ' ' || text[p] == '\t')) p++;
+      Entry entry;
+      if(p + 64 > end || !decode(text + p, entry.hash)) continue;
+      entry.offset = *start;
+      entry.length = end - *start;
+      entries.append(entry);
+      break;
+    }
+    start.reset();
+  };
+
+  for(uint64_t line = 0; line < size;) {
+    uint64_t next = line;
+    while(next < size && text[next] != '\n') next++;
+    if(next < size) next++;
+    char c = text[line];
+    if(c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+      finish(line);
+      if(c != '/') start = line;
+    }
+    line = next;
+  }
+  finish(size);
+
+  uint capacity = 1;
+  while(capacity < entries.size() * 2) capacity <<= 1;
+
+  vector<uint8_t> index;
+  index.resize(HeaderSize + capacity * SlotSize);
+  memory::fill(index.data(), index.size());
+  memory::copy(index.data(), "BMLX", 4);
+  memory::writel<4>(index.data() + 4, Version);
+  memory::writel<8>(index.data() + 8, sourceSize);
+  memory::writel<8>(index.data() + 16, sourceTime);
+  memory::writel<4>(index.data() + 24, capacity);
+
+  uint count = 0;
+  auto slots = index.data() + HeaderSize;
+  for(auto& entry : entries) {
+    uint n = memory::readl<4>(entry.hash) & capacity - 1;
+    bool duplicate = false;
+    //the first occurrence wins, as it would for a query on the parsed document
+    for(; memory::readl<4>(slots + n * SlotSize + 36); n = n + 1 & capacity - 1) {
+      if(!memory::compare(slots + n * SlotSize, entry.hash, 32)) { duplicate = true; break; }
+    }
+    if(duplicate) continue;
+    memory::copy(slots + n * SlotSize, entry.hash, 32);
+    memory::writel<4>(slots + n * SlotSize + 32, entry.offset);
+    memory::writel<4>(slots + n * SlotSize + 36, entry.length);
+    count++;
+  }
+  memory::writel<4>(index.data() + 28, count);
+  return index;
+}
+
+auto Database::decode(const char* hex, uint8_t* hash) -> bool {
+  auto nibble = [](char c) -> int {
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+  };
+  for(uint n : range(32)) {
+    int hi = nibble(hex[n * 2 + 0]);
+    int lo = nibble(hex[n * 2 + 1]);
+    if(hi < 0 || lo < 0) return false;
+    hash[n] = hi << 4 | lo;
+  }
+  return true;
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace Heuristics {
+
+//looks up the top-level nodes of a BML database (Super Famicom.bml, Cheat Codes.bml, ...) by their sha256.
+//parsing the whole database takes tens of milliseconds, so a hash index of the nodes is compiled once,
+//saved beside the database as name.idx, and rebuilt whenever the database changes size or timestamp.
+//both files are memory-mapped, and only the text of the matching node is parsed.
+//if the index cannot be written (eg a read-only install), it is kept in memory for this session instead.
+struct Database {
+  auto open(const string& location) -> bool;
+  auto close() -> void;
+  auto find(const string& sha256) -> Markup::Node;
+  auto size() const -> uint { return slots ? count : 0; }
+
+private:
+  //index file: header, then a power-of-two number of slots, probed linearly from the low bits of the hash.
+  //each slot holds the raw hash and the byte range of its node in the database; empty slots have no length.
+  enum : uint { HeaderSize = 32, SlotSize = 40, Version = 1 };
+
+  auto fresh(const uint8_t* data, uint64_t size) const -> bool;
+  auto build() -> vector<uint8_t>;
+  static auto decode(const char* hex, uint8_t* hash) -> bool;
+
+  string location;
+  uint64_t sourceSize = 0;
+  uint64_t sourceTime = 0;
+  file_map source;
+  file_map mapped;
+  vector<uint8_t> built;  //used when the index could not be written
+  const uint8_t* slots = nullptr;
+  uint capacity = 0;
+  uint count = 0;
+};
+
+}
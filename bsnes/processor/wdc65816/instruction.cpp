@@ -17,48 +17,63 @@ L PC.h = read(r.vector + 1);
 //controlled via the M/X flags, this changes the execution details of various instructions.
 //rather than implement four instruction tables for all possible combinations of these bits,
 //instead use macro abuse to generate all four tables based off of a single template table.
+//each table is a function of its own, and the one for the current flags is selected by updateTable()
+//whenever the flags change, so instruction() dispatches without testing them.
+
+//a = instructions unaffected by M/X flags
+//m = instructions affected by M flag (1 = 8-bit; 0 = 16-bit)
+//x = instructions affected by X flag (1 = 8-bit; 0 = 16-bit)
+#define opA(id, name, ...) case id: return instruction##name(__VA_ARGS__);
+
+#define opM(id, name, ...) case id: return instruction##name##8(__VA_ARGS__);
+#define m(name) &WDC65816::algorithm##name##8
+#define opX(id, name, ...) case id: return instruction##name##8(__VA_ARGS__);
+#define x(name) &WDC65816::algorithm##name##8
+auto WDC65816::instructionM8X8() -> void {
+  #include "instruction.hpp"
+}
+#undef opX
+#undef x
+#define opX(id, name, ...) case id: return instruction##name##16(__VA_ARGS__);
+#define x(name) &WDC65816::algorithm##name##16
+auto WDC65816::instructionM8X16() -> void {
+  #include "instruction.hpp"
+}
+#undef opX
+#undef x
+#undef opM
+#undef m
+
+#define opM(id, name, ...) case id: return instruction##name##16(__VA_ARGS__);
+#define m(name) &WDC65816::algorithm##name##16
+#define opX(id, name, ...) case id: return instruction##name##8(__VA_ARGS__);
+#define x(name) &WDC65816::algorithm##name##8
+auto WDC65816::instructionM16X8() -> void {
+  #include "instruction.hpp"
+}
+#undef opX
+#undef x
+#define opX(id, name, ...) case id: return instruction##name##16(__VA_ARGS__);
+#define x(name) &WDC65816::algorithm##name##16
+auto WDC65816::instructionM16X16() -> void {
+  #include "instruction.hpp"
+}
+#undef opX
+#undef x
+#undef opM
+#undef m
+
+#undef opA
+
 auto WDC65816::instruction() -> void {
-  //a = instructions unaffected by M/X flags
-  //m = instructions affected by M flag (1 = 8-bit; 0 = 16-bit)
-  //x = instructions affected by X flag (1 = 8-bit; 0 = 16-bit)
+  (this->*table)();
+}
 
-  #define opA(id, name, ...) case id: return instruction##name(__VA_ARGS__);
-  if(MF) {
-    #define opM(id, name, ...) case id: return instruction##name##8(__VA_ARGS__);
-    #define m(name) &WDC65816::algorithm##name##8
-    if(XF) {
-      #define opX(id, name, ...) case id: return instruction##name##8(__VA_ARGS__);
-      #define x(name) &WDC65816::algorithm##name##8
-      #include "instruction.hpp"
-      #undef opX
-      #undef x
-    } else {
-      #define opX(id, name, ...) case id: return instruction##name##16(__VA_ARGS__);
-      #define x(name) &WDC65816::algorithm##name##16
-      #include "instruction.hpp"
-      #undef opX
-      #undef x
-    }
-    #undef opM
-    #undef m
-  } else {
-    #define opM(id, name, ...) case id: return instruction##name##16(__VA_ARGS__);
-    #define m(name) &WDC65816::algorithm##name##16
-    if(XF) {
-      #define opX(id, name, ...) case id: return instruction##name##8(__VA_ARGS__);
-      #define x(name) &WDC65816::algorithm##name##8
-      #include "instruction.hpp"
-      #undef opX
-      #undef x
-    } else {
-      #define opX(id, name, ...) case id: return instruction##name##16(__VA_ARGS__);
-      #define x(name) &WDC65816::algorithm##name##16
-      #include "instruction.hpp"
-      #undef opX
-      #undef x
-    }
-    #undef opM
-    #undef m
-  }
-  #undef opA
+//must be called after every change to the M or X flags, including writes from outside the core:
+auto WDC65816::updateTable() -> void {
+  static const Table tables[4] = {
+    &WDC65816::instructionM16X16, &WDC65816::instructionM16X8,
+    &WDC65816::instructionM8X16,  &WDC65816::instructionM8X8,
+  };
+  table = tables[MF << 1 | XF];
 }
@@ -85,6 +85,7 @@ L idleIRQ();
   if(EF) {
     XF = 1;
     MF = 1;
+    updateTable();
     X.h = 0x00;
     Y.h = 0x00;
     S.h = 0x01;
@@ -107,6 +108,7 @@ L idle();
   P = P & ~W.l;
 E XF = 1, MF = 1;
   if(XF) X.h = 0x00, Y.h = 0x00;
+  updateTable();
 }
 
 auto WDC65816::instructionSetP() -> void {
@@ -115,6 +117,7 @@ L idle();
   P = P | W.l;
 E XF = 1, MF = 1;
   if(XF) X.h = 0x00, Y.h = 0x00;
+  updateTable();
 }
 
 auto WDC65816::instructionTransfer8(r16 F, r16& T) -> void {
@@ -216,6 +219,7 @@ auto WDC65816::instructionPullP() -> void {
 L P = pull();
 E XF = 1, MF = 1;
   if(XF) X.h = 0x00, Y.h = 0x00;
+  updateTable();
 }
 
 auto WDC65816::instructionPushEffectiveAddress() -> void {
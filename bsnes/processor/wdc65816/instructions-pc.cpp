@@ -108,6 +108,7 @@ auto WDC65816::instructionReturnInterrupt() -> void {
   P = pull();
 E XF = 1, MF = 1;
   if(XF) X.h = 0x00, Y.h = 0x00;
+  updateTable();
   PC.l = pull();
   if(EF) {
   L PC.h = pull();
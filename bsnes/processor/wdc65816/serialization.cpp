@@ -30,4 +30,6 @@ auto WDC65816::serialize(serializer& s) -> void {
   s.integer(r.u.d);
   s.integer(r.v.d);
   s.integer(r.w.d);
+
+  if(s.mode() == serializer::Load) updateTable();
 }
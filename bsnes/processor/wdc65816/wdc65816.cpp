@@ -24,6 +24,7 @@ auto WDC65816::power() -> void {
   r.b  = 0x00;
   r.p  = 0x34;
   r.e  = 1;
+  updateTable();
 
   r.irq = 0;
   r.wai = 0;
@@ -223,7 +223,12 @@ struct WDC65816 {
   auto instructionPushEffectiveRelativeAddress() -> void;
 
   //instruction.cpp
+  auto instructionM8X8() -> void;
+  auto instructionM8X16() -> void;
+  auto instructionM16X8() -> void;
+  auto instructionM16X16() -> void;
   auto instruction() -> void;
+  auto updateTable() -> void;
 
   //serialization.cpp
   auto serialize(serializer&) -> void;
@@ -283,6 +288,9 @@ struct WDC65816 {
     r24 v;  //temporary register
     r24 w;  //temporary register
   } r;
+
+  using Table = auto (WDC65816::*)() -> void;
+  Table table = &WDC65816::instructionM8X8;  //the instruction table for the current M/X flags
 };
 
 }
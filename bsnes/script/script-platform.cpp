@@ -134,6 +134,11 @@ auto Platform::scriptCreateContext() -> asIScriptContext* {
     asCALL_CDECL
   );
 
+#if defined(AS_PROFILER_ENABLE)
+  // call sites and delegates run on their own contexts; sample them too once the profiler is on:
+  scriptEngineState.profiler.attach(context);
+#endif
+
   return context;
 }
 
@@ -146,7 +151,14 @@ auto Platform::scriptPrimaryContext() -> asIScriptContext* {
 }
 
 auto Platform::scriptExecute(asIScriptContext *ctx) -> asUINT {
+  auto &timing = scriptEngineState.timing;
+  uint64_t start = timing.enabled && !timing.depth ? chrono::nanosecond() : 0;
+
+  timing.depth++;
   auto r = ctx->Execute();
+  timing.depth--;
+
+  if (start) timing.nanoseconds += chrono::nanosecond() - start;
   scriptEngineState.profiler.resetLocation();
   return r;
 }
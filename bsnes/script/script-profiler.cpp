@@ -54,6 +54,15 @@ auto Profiler::enable(asIScriptContext *ctx) -> void {
 
   enabled = true;
   thrProfiler = nall::thread::create({&Profiler::samplingThread, this});
+  mtx.unlock();
+
+  attach(ctx);
+}
+
+// samples the given context as well while the profiler is enabled:
+auto Profiler::attach(asIScriptContext *ctx) -> void {
+  if (!enabled) return;
+
   //ctx->SetLineCallback(asMETHOD(ScriptInterface::Profiler, lineCallback), this, asCALL_THISCALL);
   ctx->SetLineCallback(
     asFUNCTION(+([](asIScriptContext *ctx, Profiler &self) {
@@ -62,8 +71,6 @@ auto Profiler::enable(asIScriptContext *ctx) -> void {
     this,
     asCALL_CDECL
   );
-
-  mtx.unlock();
 }
 
 auto Profiler::disable(asIScriptContext *ctx) -> void {
@@ -66,6 +66,7 @@ struct Profiler {
 
   auto lineCallback(asIScriptContext *ctx) -> void;
   auto enable(asIScriptContext *ctx) -> void;
+  auto attach(asIScriptContext *ctx) -> void;
   auto disable(asIScriptContext *ctx) -> void;
   void reset();
   void save();
@@ -116,6 +117,13 @@ public:
 
     Profiler profiler;
 
+    // host time spent executing script code, accumulated while enabled; nested executions are counted once:
+    struct Timing {
+      bool     enabled     = false;
+      uint     depth       = 0;
+      uint64_t nanoseconds = 0;
+    } timing;
+
     vector<asIScriptModule *> modules;
     asIScriptModule          *main_module = nullptr;
 
@@ -129,6 +137,69 @@ protected:
   virtual auto formatStackFrame(const char *scriptSection, int line, int column, const asIScriptFunction *func = nullptr) -> string;
 };
 
+// a script function pre-bound to a fixed native signature. each call site owns a dedicated context
+// and sets its arguments directly, so hot hooks avoid building a type-erased closure per invocation:
+template<typename... P> struct CallSite {
+  CallSite(Platform *platform, asIScriptFunction *func) : platform(platform), func(func) {
+    if (func) func->AddRef();
+  }
+  CallSite(const CallSite& source) : platform(source.platform), func(source.func) {
+    if (func) func->AddRef();
+  }
+  CallSite(CallSite&& source) : platform(source.platform), func(source.func), context(source.context) {
+    source.func = nullptr;
+    source.context = nullptr;
+  }
+  ~CallSite() {
+    if (context) context->Release();
+    if (func) func->Release();
+  }
+  auto operator=(const CallSite&) -> CallSite& = delete;
+
+  explicit operator bool() const { return func; }
+
+  auto operator()(P... p) -> asUINT {
+    if (!func) return 0;
+    if (!context) context = platform->scriptCreateContext();
+
+    // the callback may trigger this same call site again; nest on the existing context:
+    bool nested = context->GetState() == asEXECUTION_ACTIVE;
+    if (nested && context->PushState() < 0) return asEXECUTION_ERROR;
+
+    // preparing the same function again is cheap; the context keeps its stack and lookups:
+    context->Prepare(func);
+    setArgs(0, p...);
+    auto r = platform->scriptExecute(context);
+
+    if (nested) context->PopState();
+    return r;
+  }
+
+private:
+  auto setArgs(asUINT n) -> void {}
+  template<typename T, typename... Q> auto setArgs(asUINT n, T t, Q... q) -> void {
+    setArg(n, t);
+    setArgs(n + 1, q...);
+  }
+
+  auto setArg(asUINT n, bool value)     -> void { context->SetArgByte(n, value); }
+  auto setArg(asUINT n, int8_t value)   -> void { context->SetArgByte(n, value); }
+  auto setArg(asUINT n, uint8_t value)  -> void { context->SetArgByte(n, value); }
+  auto setArg(asUINT n, int16_t value)  -> void { context->SetArgWord(n, value); }
+  auto setArg(asUINT n, uint16_t value) -> void { context->SetArgWord(n, value); }
+  auto setArg(asUINT n, int32_t value)  -> void { context->SetArgDWord(n, value); }
+  auto setArg(asUINT n, uint32_t value) -> void { context->SetArgDWord(n, value); }
+  auto setArg(asUINT n, int64_t value)  -> void { context->SetArgQWord(n, value); }
+  auto setArg(asUINT n, uint64_t value) -> void { context->SetArgQWord(n, value); }
+  auto setArg(asUINT n, float value)    -> void { context->SetArgFloat(n, value); }
+  auto setArg(asUINT n, double value)   -> void { context->SetArgDouble(n, value); }
+  template<typename T> auto setArg(asUINT n, T* value) -> void { context->SetArgObject(n, (void *)value); }
+
+  Platform *platform = nullptr;
+  asIScriptFunction *func = nullptr;
+  asIScriptContext *context = nullptr;
+};
+
 // the interface that sfc implements:
 struct Interface {
 
@@ -4,6 +4,7 @@ namespace SuperFamicom {
 
 MSU1 msu1;
 
+#include "streamer.cpp"
 #include "serialization.cpp"
 
 auto MSU1::synchronizeCPU() -> void {
@@ -23,18 +24,20 @@ auto MSU1::main() -> void {
   double right = 0.0;
 
   if(io.audioPlay) {
-    if(audioFile) {
-      if(audioFile->end()) {
+    audioLoaded();
+    if(streamer) {
+      if(io.audioPlayOffset >= streamer.size()) {
         if(!io.audioRepeat) {
           io.audioPlay = false;
-          audioFile->seek(io.audioPlayOffset = 8);
+          io.audioPlayOffset = 8;
         } else {
-          audioFile->seek(io.audioPlayOffset = io.audioLoopOffset);
+          io.audioPlayOffset = io.audioLoopOffset;
         }
       } else {
+        uint32_t frame = streamer.read(io.audioPlayOffset);
         io.audioPlayOffset += 4;
-        left  = (double)(int16)audioFile->readl(2) / 32768.0 * (double)io.audioVolume / 255.0;
-        right = (double)(int16)audioFile->readl(2) / 32768.0 * (double)io.audioVolume / 255.0;
+        left  = (double)(int16)(frame >>  0) / 32768.0 * (double)io.audioVolume / 255.0;
+        right = (double)(int16)(frame >> 16) / 32768.0 * (double)io.audioVolume / 255.0;
         if(dsp.mute()) left = 0, right = 0;
       }
     } else {
@@ -42,7 +45,7 @@ auto MSU1::main() -> void {
     }
   }
 
-  if(!system.runAhead) stream->sample(float(left), float(right));
+  if(!system.speculative) stream->sample(float(left), float(right));
   step(1);
   synchronizeCPU();
 }
@@ -53,7 +56,8 @@ auto MSU1::step(uint clocks) -> void {
 
 auto MSU1::unload() -> void {
   dataFile.reset();
-  audioFile.reset();
+  streamer.close();
+  audioPending = false;
 }
 
 auto MSU1::power() -> void {
@@ -90,23 +94,23 @@ auto MSU1::dataOpen() -> void {
   }
 }
 
+//the track is opened and its header read on the streamer's worker, while emulation continues.
+//the header sets the emulated error flag and loop offset, so audioLoaded() waits for it
+//before either is first observed by the game, played from, or saved.
 auto MSU1::audioOpen() -> void {
-  audioFile.reset();
-  string name = {"msu1/track-", io.audioTrack, ".pcm"};
-  if(audioFile = platform->open(ID::SuperFamicom, name, File::Read)) {
-    if(audioFile->size() >= 8) {
-      uint32 header = audioFile->readm(4);
-      if(header == 0x4d535531) {  //"MSU1"
-        io.audioLoopOffset = 8 + audioFile->readl(4) * 4;
-        if(io.audioLoopOffset > audioFile->size()) io.audioLoopOffset = 8;
-        io.audioError = false;
-        audioFile->seek(io.audioPlayOffset);
-        return;
-      }
-    }
-    audioFile.reset();
+  streamer.open(io.audioTrack, io.audioPlayOffset);
+  audioPending = true;
+}
+
+auto MSU1::audioLoaded() -> void {
+  if(!audioPending) return;
+  audioPending = false;
+  if(streamer.wait()) {
+    io.audioLoopOffset = streamer.loopOffset();
+    io.audioError = false;
+  } else {
+    io.audioError = true;
   }
-  io.audioError = true;
 }
 
 auto MSU1::readIO(uint addr, uint8) -> uint8 {
@@ -114,6 +118,7 @@ auto MSU1::readIO(uint addr, uint8) -> uint8 {
 
   switch(0x2000 | addr & 7) {
   case 0x2000:
+    audioLoaded();
     return (
       Revision       << 0
     | io.audioError  << 3
@@ -166,6 +171,7 @@ auto MSU1::writeIO(uint addr, uint8 data) -> void {
     io.audioVolume = data;
     break;
   case 0x2007:
+    audioLoaded();
     if(io.audioBusy) break;
     if(io.audioError) break;
     io.audioPlay = bool(data & 1);
@@ -10,6 +10,7 @@ struct MSU1 : Thread {
 
   auto dataOpen() -> void;
   auto audioOpen() -> void;
+  auto audioLoaded() -> void;
 
   auto readIO(uint addr, uint8 data) -> uint8;
   auto writeIO(uint addr, uint8 data) -> void;
@@ -17,8 +18,67 @@ struct MSU1 : Thread {
   auto serialize(serializer&) -> void;
 
 private:
+  //streamer.cpp
+  //audio tracks are read ahead on a background thread into a ring of fixed-size blocks of raw PCM,
+  //so that the MSU1 thread does not wait on the file system while a track plays or loops.
+  //blocks are tagged with their position in the track, and every sample is still taken from the
+  //exact offset being played: how far ahead the reader is never changes the output, and a block
+  //that is not ready yet is waited for rather than skipped.
+  //the worker also opens each requested track and reads its header; wait() collects the result.
+  struct Streamer {
+    struct Header {
+      bool valid = false;
+      uint32_t size = 0;
+      uint32_t loopOffset = 8;
+    };
+
+    ~Streamer();
+    explicit operator bool() const { return header.valid; }
+    auto open(uint track, uint32_t offset) -> void;
+    auto wait() -> bool;
+    auto close() -> void;
+    auto seek(uint32_t offset) -> void;
+    auto read(uint32_t offset) -> uint32_t;
+    auto size() const -> uint32_t { return header.size; }
+    auto loopOffset() const -> uint32_t { return header.loopOffset; }
+
+  private:
+    enum : uint { BlockSize = 16384, Blocks = 32, Ahead = 8, Empty = ~0u };
+
+    auto copy(uint8_t* target, uint32_t offset, uint length) -> void;
+    auto load(uint track) -> void;
+    auto fill(uint block) -> void;
+    auto worker() -> void;
+
+    //owned by the MSU1 thread:
+    uint track = ~0;      //the track last requested
+    Header header;        //of that track, once wait() has returned
+    uint waited = 0;      //the generation header belongs to
+    uint requested = Empty;  //the last position published by the MSU1 thread
+
+    //owned by the worker:
+    shared_pointer<vfs::file> file;
+    const uint8_t* fileData = nullptr;  //set when the file is memory-mapped
+    uint fileTrack = ~0;
+    Header loaded;  //of fileTrack
+
+    //guarded by lock; blocks read for an older generation are discarded:
+    uint generation = 0;
+    uint opened = 0;  //the last generation whose track the worker has loaded
+
+    uint8_t data[Blocks][BlockSize];
+    std::atomic<uint> tags[Blocks];  //the block held by each slot, or Empty while it is refilled
+    std::atomic<uint> position{0};  //the block being played
+    std::atomic<uint> sleeping{0};
+    std::atomic<bool> quit{false};
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable ready;
+    std::thread thread;
+  } streamer;
+
   shared_pointer<vfs::file> dataFile;
-  shared_pointer<vfs::file> audioFile;
+  bool audioPending = false;  //audioOpen() was called and audioLoaded() has not applied its header yet
 
   enum Flag : uint {
     Revision       = 0x02,  //max: 0x07
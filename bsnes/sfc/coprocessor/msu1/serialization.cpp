@@ -1,4 +1,5 @@
 auto MSU1::serialize(serializer& s) -> void {
+  if(s.mode() != serializer::Load) audioLoaded();
   Thread::serialize(s);
 
   s.integer(io.dataSeekOffset);
@@ -0,0 +1,177 @@
+MSU1::Streamer::~Streamer() {
+  close();
+}
+
+//requests a track; the worker opens it and reads its header in the background.
+//run-ahead loads state every frame, and each load reopens the track: a track that is already open
+//is only seeked, so that the streamer keeps what it has read ahead
+auto MSU1::Streamer::open(uint track, uint32_t offset) -> void {
+  if(track == this->track && waited == generation && header.valid) return seek(offset);
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    this->track = track;
+    generation++;
+    for(auto& tag : tags) tag.store(Empty);
+    requested = offset / BlockSize;
+    position.store(requested);
+    wake.notify_one();
+  }
+  if(!thread.joinable()) thread = std::thread{[this] { worker(); }};
+}
+
+//waits until the requested track has been opened; returns whether it has a valid header
+auto MSU1::Streamer::wait() -> bool {
+  if(waited != generation) {
+    std::unique_lock<std::mutex> guard(lock);
+    ready.wait(guard, [&] { return opened == generation; });
+    header = loaded;
+    waited = generation;
+  }
+  return header.valid;
+}
+
+auto MSU1::Streamer::close() -> void {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    quit.store(true);
+    wake.notify_all();
+  }
+  if(thread.joinable()) thread.join();
+  quit.store(false);
+
+  track = ~0;
+  header = {};
+  file.reset();
+  fileData = nullptr;
+  fileTrack = ~0;
+  loaded = {};
+  opened = waited = generation;
+}
+
+//publishes the play position to the worker, so that it reads ahead from there
+auto MSU1::Streamer::seek(uint32_t offset) -> void {
+  uint block = offset / BlockSize;
+  if(block == requested) return;
+  requested = block;
+  position.store(block);
+
+  if(sleeping.load()) {
+    std::lock_guard<std::mutex> guard(lock);
+    wake.notify_one();
+  }
+}
+
+//returns the four bytes at offset; bytes past the end of the file read as zero
+auto MSU1::Streamer::read(uint32_t offset) -> uint32_t {
+  uint8_t frame[4];
+  uint head = min(4u, BlockSize - offset % BlockSize);
+  copy(frame, offset, head);
+  if(head < 4) copy(frame + head, offset + head, 4 - head);
+  return frame[0] << 0 | frame[1] << 8 | frame[2] << 16 | frame[3] << 24;
+}
+
+//copies from a single block: its tag is checked again afterward, in case the slot was refilled meanwhile
+auto MSU1::Streamer::copy(uint8_t* target, uint32_t offset, uint length) -> void {
+  uint block = offset / BlockSize;
+  auto& tag = tags[block % Blocks];
+  seek(offset);
+  while(true) {
+    if(tag.load(std::memory_order_acquire) == block) {
+      memory::copy(target, &data[block % Blocks][offset % BlockSize], length);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(tag.load(std::memory_order_relaxed) == block) return;
+    }
+    std::this_thread::yield();
+  }
+}
+
+//called by the worker without the lock held
+auto MSU1::Streamer::load(uint track) -> void {
+  file.reset();
+  fileData = nullptr;
+  fileTrack = track;
+  loaded = {};
+
+  string name = {"msu1/track-", track, ".pcm"};
+  file = platform->open(ID::SuperFamicom, name, File::Read);
+  if(!file || file->size() < 8 || file->readm(4) != 0x4d535531) return file.reset();  //"MSU1"
+  loaded.valid = true;
+  loaded.size = file->size();
+  loaded.loopOffset = 8 + file->readl(4) * 4;
+  if(loaded.loopOffset > loaded.size) loaded.loopOffset = 8;
+  fileData = file->data();
+}
+
+//called by the worker without the lock held; the caller publishes the block's tag
+auto MSU1::Streamer::fill(uint block) -> void {
+  auto& tag = tags[block % Blocks];
+  auto target = data[block % Blocks];
+  tag.store(Empty, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  uint64_t offset = (uint64_t)block * BlockSize;
+  uint length = offset < loaded.size ? min<uint64_t>(BlockSize, loaded.size - offset) : 0;
+  if(fileData) {
+    memory::copy(target, fileData + offset, length);
+  } else if(length) {
+    file->seek(offset);
+    file->read(target, length);
+  }
+  memory::fill(target + length, BlockSize - length);
+}
+
+auto MSU1::Streamer::worker() -> void {
+  std::unique_lock<std::mutex> guard(lock);
+  while(!quit.load()) {
+    //a newly requested track is opened before any block is read; the same track is not opened again:
+    if(opened != generation) {
+      uint current = generation;
+      uint track = this->track;
+      guard.unlock();
+      if(track != fileTrack || !loaded.valid) load(track);
+      guard.lock();
+      opened = current;
+      ready.notify_all();
+      continue;
+    }
+
+    //the blocks to hold, most urgent first: the one playing, the ones after it, then the loop point.
+    //a slot is never taken from a block that is wanted more urgently.
+    uint current = position.load();
+    uint loop = loaded.loopOffset / BlockSize;
+    uint wanted[Ahead + 2];
+    for(uint n : range(Ahead)) wanted[n] = current + n;
+    wanted[Ahead + 0] = loop;
+    wanted[Ahead + 1] = loop + 1;
+
+    maybe<uint> next;
+    for(uint n : range(Ahead + 2)) {
+      uint block = wanted[n];
+      if(!loaded.valid) break;
+      if(n && (uint64_t)block * BlockSize >= loaded.size) continue;
+      if(tags[block % Blocks].load() == block) continue;
+      bool taken = false;
+      for(uint m : range(n)) taken |= wanted[m] % Blocks == block % Blocks;
+      if(taken) continue;
+      next = block;
+      break;
+    }
+
+    //the block is read without the lock, so that open() never waits on the disk.
+    //if another track or position was requested meanwhile, the block is discarded.
+    //the position is read again after every block, as it may have moved on:
+    if(next) {
+      uint observed = generation;
+      guard.unlock();
+      fill(*next);
+      guard.lock();
+      if(generation == observed) tags[*next % Blocks].store(*next, std::memory_order_release);
+      continue;
+    }
+
+    uint observed = generation;
+    sleeping.fetch_add(1);
+    wake.wait(guard, [&] { return position.load() != current || generation != observed || quit.load(); });
+    sleeping.fetch_sub(1);
+  }
+}
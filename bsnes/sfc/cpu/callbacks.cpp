@@ -0,0 +1,48 @@
+auto CPU::PCCallbacks::lowerBound(uint32 addr) const -> uint {
+  uint lo = 0, hi = slots.size();
+  while(lo < hi) {
+    uint mid = lo + hi >> 1;
+    if(slots[mid].addr < addr) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+//slots are sorted by address, so every slot sharing a page with addr is adjacent to its insertion point:
+auto CPU::PCCallbacks::updatePage(uint32 addr) -> void {
+  if(addr >> 24) return;  //the PC is only 24 bits wide; these callbacks can never fire
+  uint page = addr >> 8;
+  uint index = lowerBound(addr);
+  bool used = (index < slots.size() && slots[index].addr >> 8 == page)
+           || (index > 0 && slots[index - 1].addr >> 8 == page);
+  if(used) pages[page >> 6] |=  (uint64)1 << (page & 63);
+  else     pages[page >> 6] &= ~((uint64)1 << (page & 63));
+}
+
+auto CPU::PCCallbacks::find(uint32 addr) const -> maybe<const callback&> {
+  uint index = lowerBound(addr);
+  if(index < slots.size() && slots[index].addr == addr) return slots[index].cb;
+  return nothing;
+}
+
+auto CPU::PCCallbacks::insert(uint32 addr, const callback& cb) -> void {
+  uint index = lowerBound(addr);
+  if(index < slots.size() && slots[index].addr == addr) {
+    slots[index].cb = cb;
+  } else {
+    slots.insert(index, {addr, cb});
+  }
+  updatePage(addr);
+}
+
+auto CPU::PCCallbacks::remove(uint32 addr) -> void {
+  uint index = lowerBound(addr);
+  if(index >= slots.size() || slots[index].addr != addr) return;
+  slots.remove(index);
+  updatePage(addr);
+}
+
+auto CPU::PCCallbacks::reset() -> void {
+  slots.reset();
+  memory::fill<uint64>(pages, sizeof(pages) / sizeof(uint64));
+}
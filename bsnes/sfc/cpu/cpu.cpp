@@ -9,6 +9,7 @@ CPU cpu;
 #include "timing.cpp"
 #include "irq.cpp"
 #include "serialization.cpp"
+#include "callbacks.cpp"
 
 auto CPU::synchronizeSMP() -> void {
   if(smp.clock < 0) scheduler.resume(smp.thread);
@@ -52,9 +53,12 @@ auto CPU::main() -> void {
   if(r.wai) return instructionWait();
   if(r.stp) return instructionStop();
   if(!status.interruptPending) {
-    auto intr = pc_callbacks.find(r.pc.d);
-    if (intr) {
-      intr()(r.pc.d);
+    if(pc_callbacks.test(r.pc.d)) {
+      if(auto intr = pc_callbacks.find(r.pc.d)) {
+        //copy the callback so it may safely unregister itself:
+        auto callback = intr();
+        callback(r.pc.d);
+      }
     }
     return instruction();
   }
@@ -130,6 +134,7 @@ auto CPU::power(bool reset) -> void {
       for(auto& byte : wram) byte = 0xff;
     }
   }
+  wramPages.markAll();
 
   for(uint n : range(8)) {
     channels[n] = {};
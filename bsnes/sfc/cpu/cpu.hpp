@@ -112,9 +112,38 @@ struct CPU : Processor::WDC65816, Thread, PPUcounter {
     uint32 addr
   ) -> void;
   auto reset_pc_callbacks() -> void;
-  map< uint32, function<void (uint32 addr)> > pc_callbacks;
+
+  //callbacks.cpp
+  //PC callbacks are indexed by 256-byte page so that main() only pays for a single bit test
+  //when no callback is registered near the current PC; hits fall back to a binary search.
+  struct PCCallbacks {
+    using callback = function<void (uint32 addr)>;
+
+    alwaysinline auto test(uint24 addr) const -> bool {
+      return pages[addr >> 14] >> (addr >> 8 & 63) & 1;
+    }
+
+    auto find(uint32 addr) const -> maybe<const callback&>;
+    auto insert(uint32 addr, const callback& cb) -> void;
+    auto remove(uint32 addr) -> void;
+    auto reset() -> void;
+    auto size() const -> uint { return slots.size(); }
+
+  private:
+    struct Slot {
+      uint32 addr;
+      callback cb;
+    };
+
+    auto lowerBound(uint32 addr) const -> uint;
+    auto updatePage(uint32 addr) -> void;
+
+    uint64 pages[(1 << 16) / 64] = {};  //one bit per 256-byte page of the 24-bit address space
+    vector<Slot> slots;  //sorted by addr
+  } pc_callbacks;
 
   uint8 wram[128 * 1024];
+  DirtyPages wramPages;
   vector<Thread*> coprocessors;
 
   struct Overclocking {
@@ -100,6 +100,9 @@ auto CPU::scanline() -> void {
   synchronizePPU();
   synchronizeCoprocessors();
 
+  // [jsd] deliver buffered script write interceptors:
+  if(script.write_batches) script.flushWriteBatches(vcounter() == 0);
+
   if(vcounter() == 0) {
     //HDMA setup triggers once every frame
     status.hdmaSetupPosition = (version == 1 ? 12 + 8 - dmaCounter() : 12 + dmaCounter());
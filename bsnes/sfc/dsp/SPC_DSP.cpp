@@ -735,7 +735,11 @@ ECHO_CLOCK( 28 )
 inline void SPC_DSP::echo_write( int ch )
 {
 	if ( !(m.t_echo_enabled & 0x20) )
+	{
 		SET_LE16A( ECHO_PTR( ch ), m.t_echo_out [ch] );
+		if ( m.echo_write_func )
+			m.echo_write_func( m.echo_write_data, m.t_echo_ptr + ch * 2 );
+	}
 	m.t_echo_out [ch] = 0;
 }
 ECHO_CLOCK( 29 )
@@ -839,6 +843,7 @@ void SPC_DSP::init( void* ram_64k, void* echo_64k )
 {
 	m.ram  = (uint8_t*) ram_64k;
 	m.echo = (uint8_t*) echo_64k;
+	set_echo_write( 0, 0 );
 	mute_voices( 0 );
 	disable_surround( false );
 	set_output( 0, 0 );
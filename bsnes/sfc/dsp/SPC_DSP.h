@@ -17,6 +17,11 @@ public:
 	// Initializes DSP and has it use the 64K RAM provided
 	void init( void* ram_64k, void* echo_64k );
 
+	// Sets function called with the address of every echo buffer write;
+	// used to track which pages of RAM were modified. NULL disables it.
+	typedef void (*echo_write_func_t)( void* data, int addr );
+	void set_echo_write( echo_write_func_t, void* data );
+
 	// Sets destination for output samples. If out is NULL or out_size is 0,
 	// doesn't generate any.
 	typedef short sample_t;
@@ -180,6 +185,8 @@ private:
 		// non-emulation state
 		uint8_t* ram;   // 64K shared RAM between DSP and SMP
 		uint8_t* echo;  // should point at the same memory as ram; used for older hack compatibility
+		echo_write_func_t echo_write_func;
+		void* echo_write_data;
 		int mute_mask;
 		sample_t* out;
 		sample_t* out_end;
@@ -235,12 +242,27 @@ private:
 
 public:
     bool mute() { return m.regs[r_flg] & 0x40; }
+
+    // True if an echo buffer write could reach addr before the registers are next
+    // written, i.e. under either the latched or the current FLG, ESA and EDL values.
+    bool echo_window( int addr ) const;
 };
 
 #include <assert.h>
 
 inline int SPC_DSP::sample_count() const { return m.out - m.out_begin; }
 
+inline bool SPC_DSP::echo_window( int addr ) const
+{
+	if ( (m.t_echo_enabled & 0x20) && (m.regs [r_flg] & 0x20) )
+		return false;
+	int length = (m.regs [r_edl] & 0x0F) * 0x800;
+	if ( length < m.echo_length ) length = m.echo_length;
+	if ( length < 4 ) length = 4;
+	return ((addr - m.t_esa * 0x100) & 0xFFFF) < length
+	    || ((addr - m.regs [r_esa] * 0x100) & 0xFFFF) < length;
+}
+
 inline int SPC_DSP::read( int addr ) const
 {
 	assert( (unsigned) addr < register_count );
@@ -277,6 +299,12 @@ inline void SPC_DSP::write( int addr, int data )
 
 inline void SPC_DSP::mute_voices( int mask ) { m.mute_mask = mask; }
 
+inline void SPC_DSP::set_echo_write( echo_write_func_t func, void* data )
+{
+	m.echo_write_func = func;
+	m.echo_write_data = data;
+}
+
 inline bool SPC_DSP::check_kon()
 {
 	bool old = m.kon_check;
@@ -7,25 +7,41 @@ DSP dsp;
 #include "serialization.cpp"
 #include "SPC_DSP.cpp"
 
+//runs as many clocks as one clock (or one sample, with the fast DSP) at a time would to reach the SMP
 auto DSP::main() -> void {
+  int64_t behind = -clock;
   if(!configuration.hacks.dsp.fast) {
-    spc_dsp.run(1);
-    clock += 2;
+    int64_t clocks = (behind + 1) / 2;
+    spc_dsp.run(clocks);
+    clock += 2 * clocks;
   } else {
-    spc_dsp.run(32);
-    clock += 2 * 32;
+    int64_t samples = (behind + 63) / 64;
+    spc_dsp.run(32 * samples);
+    clock += 2 * 32 * samples;
   }
 
-  int count = spc_dsp.sample_count();
-  if(count > 0) {
-    if(!system.runAhead)
-    for(uint n = 0; n < count; n += 2) {
-      float left  = samplebuffer[n + 0] / 32768.0f;
-      float right = samplebuffer[n + 1] / 32768.0f;
-      stream->sample(left, right);
+  if(spc_dsp.sample_count() >= 2 * Batch) flush();
+}
+
+auto DSP::flush() -> void {
+  uint count = spc_dsp.sample_count();
+  if(!count) return;
+
+  if(!system.speculative) {
+    double samples[2 * Batch];
+    for(uint offset = 0; offset < count; offset += 2 * Batch) {
+      uint length = min(count - offset, 2 * Batch);
+      for(uint n : range(length)) samples[n] = samplebuffer[offset + n] / 32768.0;
+      stream->write(samples, length / 2);
     }
-    spc_dsp.set_output(samplebuffer, 8192);
   }
+  spc_dsp.set_output(samplebuffer, 8192);
+}
+
+auto DSP::echoes(uint16 address) const -> bool {
+  //with the echo shadow hack, the echo buffer is kept apart from APU RAM
+  if(echoShadow) return false;
+  return spc_dsp.echo_window(address);
 }
 
 auto DSP::read(uint8 address) -> uint8 {
@@ -51,8 +67,12 @@ auto DSP::power(bool reset) -> void {
   stream = Emulator::audio.createStream(2, system.apuFrequency() / 768.0);
 
   if(!reset) {
-    if(!configuration.hacks.dsp.echoShadow) {
+    echoShadow = configuration.hacks.dsp.echoShadow;
+    if(!echoShadow) {
       spc_dsp.init(apuram, apuram);
+      spc_dsp.set_echo_write([](void* data, int address) {
+        ((DSP*)data)->apuramPages.mark(address);
+      }, this);
     } else {
       memset(echoram, 0x00, 65536);
       spc_dsp.init(apuram, echoram);
@@ -63,6 +83,7 @@ auto DSP::power(bool reset) -> void {
     spc_dsp.soft_reset();
     spc_dsp.set_output(samplebuffer, 8192);
   }
+  apuramPages.markAll();
 
   if(configuration.hacks.hotfixes) {
     //Magical Drop (Japan) does not initialize the DSP registers at startup:
@@ -1,10 +1,19 @@
 #include "SPC_DSP.h"
 
 struct DSP {
+  //the DSP runs behind the SMP by up to Latency clocks, and catches up in one block.
+  //the SMP catches it up before it touches the DSP registers, writes APU RAM, or reads the echo buffer,
+  //so this is exact: the DSP never observes or produces anything at a different time than before.
+  //samples are handed to the audio stream once Batch stereo samples have been produced.
+  enum : uint { Latency = 2048, Batch = 64 };
+
   shared_pointer<Emulator::Stream> stream;
   uint8 apuram[64 * 1024] = {};
+  DirtyPages apuramPages;
 
   auto main() -> void;
+  auto flush() -> void;
+  auto echoes(uint16 address) const -> bool;
   auto read(uint8 address) -> uint8;
   auto write(uint8 address, uint8 data) -> void;
 
@@ -18,6 +27,7 @@ struct DSP {
 
 private:
   bool fastDSP = false;
+  bool echoShadow = false;
   SPC_DSP spc_dsp;
   int16 samplebuffer[8192];
 
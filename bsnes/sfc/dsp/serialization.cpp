@@ -9,7 +9,11 @@ static auto dsp_state_load(unsigned char** in, void* out, size_t size) -> void {
 }
 
 auto DSP::serialize(serializer& s) -> void {
-  s.array(apuram);
+  //states are taken with the DSP caught up and its samples delivered, as they were before it ran in blocks
+  smp.synchronizeDSP();
+  flush();
+
+  apuramPages.serialize(s, apuram, sizeof(apuram));
   s.array(samplebuffer);
   s.integer(clock);
 
@@ -40,6 +40,10 @@ auto Configuration::process(Markup::Node document, bool load) -> void {
   bind(natural, "Hacks/SA1/Overclock", hacks.sa1.overclock);
   bind(natural, "Hacks/SuperFX/Overclock", hacks.superfx.overclock);
 
+  bind(boolean, "Network/Usb2snes/Enable", network.usb2snes.enable);
+  bind(text,    "Network/Usb2snes/Host", network.usb2snes.host);
+  bind(natural, "Network/Usb2snes/Port", network.usb2snes.port);
+
   #undef bind
 }
 
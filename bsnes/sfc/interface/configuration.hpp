@@ -66,6 +66,14 @@ struct Configuration {
     } superfx;
   } hacks;
 
+  struct Network {
+    struct Usb2snes {
+      bool enable = false;
+      string host = "127.0.0.1";
+      uint port = 23074;
+    } usb2snes;
+  } network;
+
 private:
   auto process(Markup::Node document, bool load) -> void;
 };
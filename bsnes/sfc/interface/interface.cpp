@@ -11,6 +11,9 @@
 
 #include <nall/encode/base64.hpp>
 #include <nall/thread.hpp>
+#if defined(PLATFORM_LINUX)
+#  include <sys/epoll.h>
+#endif
 #include "sha1.hpp"
 
 #include "pixel-fonts.cpp"
@@ -248,7 +251,12 @@ auto Interface::run() -> void {
   system.run();
 }
 
+auto Interface::frameCount() -> uint64 {
+  return system.frameCount;
+}
+
 auto Interface::idle() -> void {
+  script.serveUsb2snes();
   if (script.funcs.idle == nullptr) return;
 
   platform->scriptInvokeFunction(script.funcs.idle);
@@ -270,10 +278,18 @@ auto Interface::serialize(bool synchronize) -> serializer {
   return system.serialize(synchronize);
 }
 
+auto Interface::serialize(serializer& s, uint& generation) -> bool {
+  return system.serialize(s, generation);
+}
+
 auto Interface::unserialize(serializer& s) -> bool {
   return system.unserialize(s);
 }
 
+auto Interface::unserialize(serializer& s, uint generation) -> bool {
+  return system.unserialize(s, generation);
+}
+
 auto Interface::read(uint24 address) -> uint8 {
   return cpu.readDisassembler(address);
 }
@@ -368,4 +384,32 @@ auto Interface::setRunAhead(bool runAhead) -> void {
   system.runAhead = runAhead;
 }
 
+auto Interface::setSpeculative(bool speculative) -> void {
+  system.speculative = speculative;
+}
+
+auto Interface::profiling() -> bool {
+  return scheduler.profiler.enabled;
+}
+
+auto Interface::setProfiling(bool profiling) -> void {
+  scheduler.profiler.setEnabled(profiling);
+}
+
+//components that did not run during the frame are omitted
+auto Interface::profile() -> vector<Profile> {
+  using Profiler = Scheduler::Profiler;
+  auto& stats = scheduler.profiler.last;
+  vector<Profile> profile;
+  for(uint n : range(Profiler::Components)) {
+    Profile entry;
+    entry.name = Profiler::Names[n];
+    entry.nanoseconds = stats.time[n];
+    entry.clocks = stats.clocks[n];
+    for(uint from : range(Profiler::Components)) entry.switches += stats.switches[from][n];
+    if(entry.nanoseconds || entry.switches) profile.append(entry);
+  }
+  return profile;
+}
+
 }
@@ -54,13 +54,16 @@ struct Interface : Emulator::Interface {
   auto power() -> void override;
   auto reset() -> void override;
   auto run() -> void override;
+  auto frameCount() -> uint64 override;
   auto idle() -> void override;
 
   auto rtc() -> bool override;
   auto synchronize(uint64 timestamp) -> void override;
 
   auto serialize(bool synchronize = true) -> serializer override;
+  auto serialize(serializer& s, uint& generation) -> bool override;
   auto unserialize(serializer&) -> bool override;
+  auto unserialize(serializer& s, uint generation) -> bool override;
 
   auto read(uint24 address) -> uint8 override;
   auto cheats(const vector<string>&) -> void override;
@@ -75,6 +78,11 @@ struct Interface : Emulator::Interface {
 
   auto runAhead() -> bool override;
   auto setRunAhead(bool runAhead) -> void override;
+  auto setSpeculative(bool speculative) -> void override;
+
+  auto profiling() -> bool override;
+  auto setProfiling(bool profiling) -> void override;
+  auto profile() -> vector<Profile> override;
 
   // script-interface.cpp
   auto registerScriptDefs(::Script::Platform *scriptPlatform) -> void override;
@@ -1,4 +1,48 @@
 
+// records intercepted writes into a preallocated buffer and hands them to the script as one batch
+// per scanline or per frame instead of executing the script callback for every single byte written:
+struct WriteBatch {
+  struct Record {
+    uint32 addr;
+    uint8  old_value;
+    uint8  new_value;
+    uint32 cycle;  // master clock offset within the frame: vcounter * 1364 + hcounter
+  };
+
+  ::Script::CallSite<WriteBatch*> call;
+  bool per_scanline;
+  vector<Record> records;
+  uint count = 0;
+
+  WriteBatch(asIScriptFunction *cb, bool per_scanline, uint capacity) : call(platform, cb), per_scanline(per_scanline) {
+    records.resize(capacity);
+  }
+
+  auto append(uint32 addr, uint8 old_value, uint8 new_value) -> void {
+    // deliver early rather than drop records when the buffer is full:
+    if (count >= records.size()) flush();
+    auto& record = records[count++];
+    record.addr = addr;
+    record.old_value = old_value;
+    record.new_value = new_value;
+    record.cycle = cpu.vcounter() * 1364 + cpu.hcounter();
+  }
+
+  auto flush() -> void {
+    if (count == 0) return;
+    call(this);
+    count = 0;
+  }
+
+  auto at(uint index) -> Record* {
+    if (index >= count) {
+      asGetActiveContext()->SetException("index out of range", true);
+      return nullptr;
+    }
+    return &records[index];
+  }
+};
+
 struct Bus {
   static auto bus_valid() -> bool {
     if (!::SuperFamicom::bus) {
@@ -202,31 +246,12 @@ struct Bus {
   }
 
   struct write_interceptor {
-    asIScriptFunction *cb;
+    ::Script::CallSite<uint32, uint8, uint8> call;
 
-    write_interceptor(asIScriptFunction *cb) : cb(cb) {
-      auto refs = cb->AddRef();
-      //printf("ctor() this=%p cb=%p refs=%d\n", this, cb, refs);
-    }
-    write_interceptor(const write_interceptor& other) : cb(other.cb) {
-      auto refs = cb->AddRef();
-      //printf("copy() this=%p cb=%p refs=%d\n", this, cb, refs);
-    }
-    write_interceptor(const write_interceptor&& other) : cb(other.cb) {
-      //printf("move() this=%p cb=%p\n", this, cb);
-    }
-    ~write_interceptor() {
-      auto refs = cb->Release();
-      //printf("dtor() this=%p cb=%p refs=%d\n", this, cb, refs);
-    }
+    write_interceptor(asIScriptFunction *cb) : call(platform, cb) {}
 
     auto operator()(uint addr, uint8 new_value, const function<uint8()> &get_old_value) -> void {
-      platform->scriptInvokeFunction(cb, [=](auto ctx) {
-        //printf("call() this=%p ctx=%p cb=%p\n", this, ctx, cb);
-        ctx->SetArgDWord(0, addr);
-        ctx->SetArgByte(1, get_old_value());
-        ctx->SetArgByte(2, new_value);
-      });
+      call(addr, get_old_value(), new_value);
     }
   };
 
@@ -238,25 +263,39 @@ struct Bus {
     ::SuperFamicom::bus.add_write_interceptor(*addr, write_interceptor(cb));
   }
 
-  struct dma_interceptor {
-    asIScriptFunction *cb;
+  struct buffered_write_interceptor {
+    WriteBatch *batch;
 
-    dma_interceptor(asIScriptFunction *cb) : cb(cb) {
-      cb->AddRef();
+    auto operator()(uint addr, uint8 new_value, const function<uint8()> &get_old_value) -> void {
+      batch->append(addr, get_old_value(), new_value);
     }
-    dma_interceptor(const dma_interceptor& other) : cb(other.cb) {
-      cb->AddRef();
+  };
+
+  static auto add_write_interceptor_buffered(const string *addr, asIScriptFunction *cb, bool per_scanline, uint capacity) -> void {
+    if (!bus_valid()) {
+      return;
     }
-    dma_interceptor(const dma_interceptor&& other) : cb(other.cb) {
+    if (capacity == 0) {
+      asGetActiveContext()->SetException("capacity must be greater than zero", true);
+      return;
     }
-    ~dma_interceptor() {
-      cb->Release();
+
+    // batches are owned by the script and freed in unloadScript(); one that got no interceptor id is never flushed:
+    auto batch = new WriteBatch(cb, per_scanline, capacity);
+    if (!::SuperFamicom::bus.add_write_interceptor(*addr, buffered_write_interceptor{batch})) {
+      delete batch;
+      return;
     }
+    script.write_batches.append(batch);
+  }
+
+  struct dma_interceptor {
+    ::Script::CallSite<const CPU::DMAIntercept*> call;
+
+    dma_interceptor(asIScriptFunction *cb) : call(platform, cb) {}
 
     auto operator()(const CPU::DMAIntercept &dma) -> void {
-      platform->scriptInvokeFunction(cb, [=](auto ctx) {
-        ctx->SetArgObject(0, (void *)&dma);
-      });
+      call(&dma);
     }
   };
 
@@ -269,24 +308,12 @@ struct Bus {
   }
 
   struct pc_interceptor {
-    asIScriptFunction *cb;
+    ::Script::CallSite<uint32> call;
 
-    pc_interceptor(asIScriptFunction *cb) : cb(cb) {
-      cb->AddRef();
-    }
-    pc_interceptor(const pc_interceptor& other) : cb(other.cb) {
-      cb->AddRef();
-    }
-    pc_interceptor(const pc_interceptor&& other) : cb(other.cb) {
-    }
-    ~pc_interceptor() {
-      cb->Release();
-    }
+    pc_interceptor(asIScriptFunction *cb) : call(platform, cb) {}
 
     auto operator()(uint32 addr) -> void {
-      platform->scriptInvokeFunction(cb, [=](auto ctx) {
-        ctx->SetArgDWord(0, addr);
-      });
+      call(addr);
     }
   };
 
@@ -331,6 +358,20 @@ auto RegisterBus(asIScriptEngine *e) -> void {
 
     r = e->RegisterFuncdef("void WriteInterceptCallback(uint32 addr, uint8 oldValue, uint8 newValue)"); assert(r >= 0);
     r = e->RegisterGlobalFunction("void add_write_interceptor(const string &in addr, WriteInterceptCallback @cb)", asFUNCTION(Bus::add_write_interceptor), asCALL_CDECL); assert(r >= 0);
+
+    // buffered write interceptors; these observe writes after the fact and cannot veto them:
+    r = e->RegisterObjectType    ("WriteRecord", sizeof(WriteBatch::Record), asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
+    r = e->RegisterObjectProperty("WriteRecord", "uint32 addr", asOFFSET(WriteBatch::Record, addr)); assert(r >= 0);
+    r = e->RegisterObjectProperty("WriteRecord", "uint8  old_value", asOFFSET(WriteBatch::Record, old_value)); assert(r >= 0);
+    r = e->RegisterObjectProperty("WriteRecord", "uint8  new_value", asOFFSET(WriteBatch::Record, new_value)); assert(r >= 0);
+    r = e->RegisterObjectProperty("WriteRecord", "uint32 cycle", asOFFSET(WriteBatch::Record, cycle)); assert(r >= 0);
+
+    r = e->RegisterObjectType    ("WriteBatch", sizeof(WriteBatch), asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
+    REG_LAMBDA(WriteBatch, "uint get_length() property", ([](WriteBatch& self) -> uint { return self.count; }));
+    REG_LAMBDA(WriteBatch, "WriteRecord@ opIndex(uint index)", ([](WriteBatch& self, uint index) -> WriteBatch::Record* { return self.at(index); }));
+
+    r = e->RegisterFuncdef("void WriteBatchCallback(WriteBatch @batch)"); assert(r >= 0);
+    r = e->RegisterGlobalFunction("void add_write_interceptor_buffered(const string &in addr, WriteBatchCallback @cb, bool per_scanline = false, uint capacity = 4096)", asFUNCTION(Bus::add_write_interceptor_buffered), asCALL_CDECL); assert(r >= 0);
   }
 
   {
@@ -342,8 +383,11 @@ auto RegisterBus(asIScriptEngine *e) -> void {
     r = e->RegisterObjectProperty("RegisterFlags", "bool z", asOFFSET(CPU::f8, z)); assert(r >= 0);
     r = e->RegisterObjectProperty("RegisterFlags", "bool i", asOFFSET(CPU::f8, i)); assert(r >= 0);
     r = e->RegisterObjectProperty("RegisterFlags", "bool d", asOFFSET(CPU::f8, d)); assert(r >= 0);
-    r = e->RegisterObjectProperty("RegisterFlags", "bool x", asOFFSET(CPU::f8, x)); assert(r >= 0);
-    r = e->RegisterObjectProperty("RegisterFlags", "bool m", asOFFSET(CPU::f8, m)); assert(r >= 0);
+    // the CPU selects its instruction table by the M/X flags, so writes to them go through setters that update it:
+    REG_LAMBDA(RegisterFlags, "bool get_x() property", ([](CPU::f8& self) -> bool { return self.x; }));
+    REG_LAMBDA(RegisterFlags, "void set_x(bool value) property", ([](CPU::f8& self, bool value) { self.x = value; cpu.updateTable(); }));
+    REG_LAMBDA(RegisterFlags, "bool get_m() property", ([](CPU::f8& self) -> bool { return self.m; }));
+    REG_LAMBDA(RegisterFlags, "void set_m(bool value) property", ([](CPU::f8& self, bool value) { self.m = value; cpu.updateTable(); }));
     r = e->RegisterObjectProperty("RegisterFlags", "bool v", asOFFSET(CPU::f8, v)); assert(r >= 0);
     r = e->RegisterObjectProperty("RegisterFlags", "bool n", asOFFSET(CPU::f8, n)); assert(r >= 0);
 
@@ -311,8 +311,10 @@ namespace ScriptInterface {
   #include "script-gui.cpp"
   #include "script-bml.cpp"
   #include "script-json.cpp"
+  #include "script-usb2snes.cpp"
   #include "script-discord.cpp"
   #include "script-menu.cpp"
+  #include "script-perf.cpp"
 
 };
 
@@ -579,6 +581,7 @@ auto Interface::registerScriptDefs(::Script::Platform *scriptPlatform) -> void {
 
   ScriptInterface::RegisterBML(e);
   ScriptInterface::RegisterJSON(e);
+  ScriptInterface::RegisterUsb2snes(e);
 
   {
     r = e->SetDefaultNamespace("base64"); assert(r >= 0);
@@ -607,9 +610,23 @@ auto Interface::registerScriptDefs(::Script::Platform *scriptPlatform) -> void {
 
   ScriptInterface::RegisterMenu(e);
 
+  ScriptInterface::RegisterPerf(e);
+
   r = e->SetDefaultNamespace(defaultNamespace); assert(r >= 0);
 }
 
+auto Script::flushWriteBatches(bool frame) -> void {
+  // callbacks may add batches, which grows the vector; those are flushed from the next scanline on:
+  for (uint i = 0, count = write_batches.size(); i < count; i++) {
+    auto batch = write_batches[i];
+    if (frame || batch->per_scanline) batch->flush();
+  }
+}
+
+auto Script::serveUsb2snes() -> void {
+  ScriptInterface::Usb2snes::server.serve();
+}
+
 auto Interface::loadScript(string location) -> void {
   int r;
 
@@ -699,6 +716,13 @@ auto Interface::unloadScript() -> void {
   ::SuperFamicom::cpu.reset_dma_interceptor();
   ::SuperFamicom::cpu.reset_pc_callbacks();
 
+  for (auto batch : script.write_batches) {
+    delete batch;
+  }
+  script.write_batches.reset();
+
+  ScriptInterface::Usb2snes::server.unsubscribe();
+
 #ifndef DISABLE_HIRO
   // Close any GUI windows:
   for (auto window : script.windows) {
@@ -209,11 +209,69 @@ namespace Net {
     return addr;
   }
 
+  // per-connection receive buffer that sockets read straight into and parsers consume from the front of.
+  // consumed space is reclaimed by sliding the unread bytes down before the storage would otherwise grow, so a
+  // long-lived connection settles on a single allocation instead of accumulating slack:
+  struct RecvBuffer {
+    auto size() const -> uint { return end - begin; }
+    auto data() -> uint8_t* { return storage.data() + begin; }
+    auto operator[](uint offset) const -> uint8_t { return storage[begin + offset]; }
+    auto view(uint offset, uint length) const -> array_view<uint8_t> { return {storage.data() + begin + offset, length}; }
+
+    // writable free space of at least `minimum` bytes; commit() what was written into it:
+    auto space(uint minimum) -> array_span<uint8_t> {
+      if (storage.size() - end < minimum) {
+        if (begin) {
+          memory::move(storage.data(), storage.data() + begin, end - begin);
+          end -= begin;
+          begin = 0;
+        }
+        if (storage.size() - end < minimum) storage.reallocate(bit::round(end + minimum));
+      }
+      return {storage.data() + end, uint(storage.size() - end)};
+    }
+    auto commit(uint length) -> void { end += length; }
+
+    auto consume(uint length) -> void {
+      begin += min(length, size());
+      if (begin == end) begin = end = 0;
+    }
+
+    // remove `length` bytes at `offset` and return them, consuming everything before them too. when they are all
+    // that is left and fill at least half of the storage, the storage itself is handed over instead of copied;
+    // smaller payloads are copied, so that the storage is kept for the next read rather than pinned by a message:
+    auto take(uint offset, uint length) -> vector<uint8_t> {
+      vector<uint8_t> result;
+      if (offset + length == size() && length >= storage.size() / 2) {
+        result = move(storage);
+        result.reallocateRight(end);
+        result.reallocateLeft(length);
+        begin = end = 0;
+        return result;
+      }
+      result.reallocate(length);
+      memory::copy(result.data(), data() + offset, length);
+      consume(offset + length);
+      return result;
+    }
+
+    auto reset() -> void {
+      storage.reset();
+      begin = end = 0;
+    }
+
+  private:
+    vector<uint8_t> storage;
+    uint begin = 0;
+    uint end = 0;
+  };
+
   struct Socket {
     int fd = -1;
 
     // already-created socket:
     Socket(int fd) : fd(fd) {
+      ref = 1;
     }
 
     // create a new socket:
@@ -333,6 +391,13 @@ namespace Net {
       return rc;
     }
 
+    // give up ownership of the descriptor without closing it:
+    auto detach() -> int {
+      int result = fd;
+      fd = -1;
+      return result;
+    }
+
     operator bool() { return fd >= 0; }
 
     // indicates data is ready to be read:
@@ -347,6 +412,9 @@ namespace Net {
       ready_out = value;
     }
 
+    // number of Pollers watching this socket; while non-zero, ready_in and ready_out are kept up to date by them:
+    uint pollers = 0;
+
     // bind to an address:
     auto bind(const Address *addr) -> int {
       if (fd < 0) return 0;
@@ -408,6 +476,21 @@ namespace Net {
         delete conn;
         return nullptr;
       }
+
+      // accepted sockets do not inherit non-blocking mode on every platform:
+      int yes = 1;
+#if !defined(PLATFORM_WINDOWS)
+      int rc = ioctl(afd, FIONBIO, &yes); last_error_location = LOCATION " ioctl";
+#else
+      int rc = ioctlsocket(afd, FIONBIO, (u_long *)&yes); last_error_location = LOCATION " ioctlsocket";
+#endif
+      if (rc < 0) {
+        last_error = sock_capture_error();
+        conn->closeNoError();
+        delete conn;
+        exception_thrown();
+        return nullptr;
+      }
       script.sockets.append(conn);
 
       return conn;
@@ -497,18 +580,21 @@ namespace Net {
       return rc;
     }
 
+    // receive everything available directly onto the end of `s`:
     auto recv_append(string &s) -> uint64_t {
       if (fd < 0) return 0;
 
-      uint8_t rawbuf[4096];
       uint64_t total = 0;
 
       for (;;) {
+        uint64_t to = s.size();
+        s.resize(to + 4096);
 #if !defined(PLATFORM_WINDOWS)
-        int rc = ::recv(fd, rawbuf, 4096, 0); last_error_location = LOCATION " recv";
+        int rc = ::recv(fd, s.get() + to, 4096, 0); last_error_location = LOCATION " recv";
 #else
-        int rc = ::recv(fd, (char *)rawbuf, 4096, 0); last_error_location = LOCATION " recv";
+        int rc = ::recv(fd, (char *)s.get() + to, 4096, 0); last_error_location = LOCATION " recv";
 #endif
+        s.resize(to + max(rc, 0));
         last_error = 0;
         if (rc < 0) {
           last_error = sock_capture_error();
@@ -521,25 +607,22 @@ namespace Net {
           return total;
         }
 
-        // append to string:
-        uint64_t to = s.size();
-        s.resize(s.size() + rc);
-        memory::copy(s.get() + to, rawbuf, rc);
         total += rc;
       }
     }
 
-    auto recv_buffer(vector<uint8_t>& buffer) -> uint64_t {
+    // receive everything available directly into the free space of `buffer`:
+    auto recv_buffer(RecvBuffer& buffer) -> uint64_t {
       if (fd < 0) return 0;
 
-      uint8_t rawbuf[4096];
       uint64_t total = 0;
 
       for (;;) {
+        auto space = buffer.space(4096);
 #if !defined(PLATFORM_WINDOWS)
-        int rc = ::recv(fd, rawbuf, 4096, 0); last_error_location = LOCATION " recv";
+        int rc = ::recv(fd, space.data(), space.size(), 0); last_error_location = LOCATION " recv";
 #else
-        int rc = ::recv(fd, (char *)rawbuf, 4096, 0); last_error_location = LOCATION " recv";
+        int rc = ::recv(fd, (char *)space.data(), space.size(), 0); last_error_location = LOCATION " recv";
 #endif
         last_error = 0;
         if (rc < 0) {
@@ -552,8 +635,7 @@ namespace Net {
           return total;
         }
 
-        // append to buffer:
-        buffer.appends({rawbuf, (uint)rc});
+        buffer.commit(rc);
         total += rc;
       }
     }
@@ -595,15 +677,50 @@ namespace Net {
     return socket;
   }
 
-  struct WebSocketMessage {
-    uint8           opcode;
-    vector<uint8_t> bytes;
+  // watches many sockets at once: one epoll_wait() on Linux, or poll() elsewhere, reports every socket that is ready,
+  // so a script serving many peers makes one syscall per frame instead of one per socket.
+  struct Poller {
+    enum : uint {
+      Readable = 1 << 0,
+      Writable = 1 << 1,
+      Closed   = 1 << 2,  // hangup or error; always reported, and also reported as Readable so recv() sees it
+    };
+
+    struct Entry {
+      Socket* socket;
+      uint interest;
+    };
+
+    vector<Entry> entries;
+    vector<Socket*> ready;
+    vector<uint> events;
+
+#if defined(PLATFORM_LINUX)
+    int epfd = -1;
+    vector<epoll_event> kernel_events;
+#else
+    vector<pollfd> fds;
+#endif
 
-    WebSocketMessage(uint8 opcode) : opcode(opcode)
-    {
+    Poller() {
       ref = 1;
+#if defined(PLATFORM_LINUX)
+      epfd = ::epoll_create1(EPOLL_CLOEXEC); last_error_location = LOCATION " epoll_create1";
+      last_error = 0;
+      if (epfd < 0) {
+        last_error = sock_capture_error();
+        exception_thrown();
+      }
+#endif
+    }
+
+    ~Poller() {
+      reset();
+#if defined(PLATFORM_LINUX)
+      if (epfd >= 0) ::close(epfd);
+      epfd = -1;
+#endif
     }
-    ~WebSocketMessage() = default;
 
     int ref;
     void addRef() {
@@ -614,55 +731,206 @@ namespace Net {
         delete this;
     }
 
-    auto get_opcode() -> uint8 { return opcode; }
-    auto set_opcode(uint8 value) -> void { opcode = value; }
+    operator bool() {
+#if defined(PLATFORM_LINUX)
+      return epfd >= 0;
+#else
+      return true;
+#endif
+    }
 
-    auto as_string() -> string* {
-      auto s = new string();
-      s->resize(bytes.size());
-      memory::copy(s->get(), bytes.data(), bytes.size());
-      return s;
+    auto find(Socket* socket) -> maybe<uint> {
+      for (uint i : range(entries.size())) {
+        if (entries[i].socket == socket) return i;
+      }
+      return nothing;
     }
 
-    auto as_array() -> CScriptArray* {
-      asIScriptContext *ctx = asGetActiveContext();
-      if (!ctx) return nullptr;
+    // start watching a socket for the given Readable/Writable interest, or change the interest if already watched:
+    auto add(Socket* socket, uint interest) -> bool {
+      if (!socket || !*socket) return false;
 
-      asIScriptEngine* engine = ctx->GetEngine();
-      asITypeInfo* t = engine->GetTypeInfoByDecl("array<uint8>");
+      auto index = find(socket);
+#if defined(PLATFORM_LINUX)
+      epoll_event event{};
+      event.events = (interest & Readable ? EPOLLIN : 0) | (interest & Writable ? EPOLLOUT : 0);
+      event.data.ptr = socket;
+      int rc = ::epoll_ctl(epfd, index ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, socket->fd, &event); last_error_location = LOCATION " epoll_ctl";
+      last_error = 0;
+      if (rc < 0) {
+        last_error = sock_capture_error();
+        exception_thrown();
+        return false;
+      }
+#endif
 
-      uint64_t size = bytes.size();
-      auto a = CScriptArray::Create(t, size);
-      if (size > 0) {
-        memory::copy(a->At(0), bytes.data(), size);
+      if (index) {
+        entries[*index].interest = interest;
+        return true;
       }
-      return a;
+      socket->addRef();
+      socket->pollers++;
+      entries.append({socket, interest});
+      return true;
     }
 
-    auto set_payload_as_string(string *s) -> void {
-      bytes.resize(s->size());
-      memory::copy(bytes.data(), s->data(), s->size());
+    // stop watching a socket:
+    auto remove(Socket* socket) -> bool {
+      auto index = find(socket);
+      if (!index) return false;
+      removeAt(*index);
+      return true;
     }
 
-    auto set_payload_as_array(CScriptArray *a) -> void {
-      bytes.resize(a->GetSize());
-      memory::copy(bytes.data(), a->At(0), a->GetSize());
+    auto reset() -> void {
+      while (entries.size()) removeAt(entries.size() - 1);
+      ready.reset();
+      events.reset();
+    }
+
+    // wait up to timeout milliseconds (0 to not wait at all) for any watched socket to become ready.
+    // returns the number of ready sockets, which are then available from get_ready() and get_events().
+    auto poll(int timeout = 0) -> int {
+      for (auto socket : ready) {
+        socket->ready_in = false;
+        socket->ready_out = false;
+      }
+      ready.reset();
+      events.reset();
+
+      // sockets closed since the last poll are no longer watched by the kernel, so stop tracking them too:
+      for (uint i = entries.size(); i > 0; i--) {
+        if (!*entries[i - 1].socket) removeAt(i - 1);
+      }
+      if (entries.size() == 0) return 0;
+
+#if defined(PLATFORM_LINUX)
+      kernel_events.resize(entries.size());
+      int rc = ::epoll_wait(epfd, kernel_events.data(), kernel_events.size(), timeout); last_error_location = LOCATION " epoll_wait";
+      last_error = 0;
+      if (rc < 0) {
+        last_error = sock_capture_error();
+        // a signal arriving during the wait is not an error worth reporting:
+        if (last_error == EINTR) last_error = 0;
+        else exception_thrown();
+        return 0;
+      }
+      for (uint i : range(rc)) {
+        auto& event = kernel_events[i];
+        uint flags = 0;
+        if (event.events & EPOLLIN) flags |= Readable;
+        if (event.events & EPOLLOUT) flags |= Writable;
+        if (event.events & (EPOLLHUP | EPOLLERR)) flags |= Closed | Readable;
+        mark((Socket*)event.data.ptr, flags);
+      }
+#else
+      fds.resize(entries.size());
+      for (uint i : range(entries.size())) {
+        fds[i].fd = entries[i].socket->fd;
+        fds[i].events = (entries[i].interest & Readable ? POLLIN : 0) | (entries[i].interest & Writable ? POLLOUT : 0);
+        fds[i].revents = 0;
+      }
+      int rc = ::poll(fds.data(), fds.size(), timeout); last_error_location = LOCATION " poll";
+      last_error = 0;
+      if (rc < 0) {
+        last_error = sock_capture_error();
+        exception_thrown();
+        return 0;
+      }
+      for (uint i : range(fds.size())) {
+        auto revents = fds[i].revents;
+        if (!revents) continue;
+        uint flags = 0;
+        if (revents & POLLIN) flags |= Readable;
+        if (revents & POLLOUT) flags |= Writable;
+        if (revents & (POLLHUP | POLLERR | POLLNVAL)) flags |= Closed | Readable;
+        mark(entries[i].socket, flags);
+      }
+#endif
+
+      return ready.size();
+    }
+
+    auto get_count() -> uint { return entries.size(); }
+    auto get_ready_count() -> uint { return ready.size(); }
+
+    auto get_ready(uint i) -> Socket* {
+      if (i >= ready.size()) return nullptr;
+      return ready[i];
+    }
+
+    auto get_events(uint i) -> uint {
+      if (i >= events.size()) return 0;
+      return events[i];
+    }
+
+  private:
+    auto mark(Socket* socket, uint flags) -> void {
+      socket->ready_in = flags & Readable;
+      socket->ready_out = flags & Writable;
+      ready.append(socket);
+      events.append(flags);
+    }
+
+    auto removeAt(uint index) -> void {
+      auto socket = entries[index].socket;
+#if defined(PLATFORM_LINUX)
+      // closing a socket already removes it from the epoll set:
+      if (*socket) ::epoll_ctl(epfd, EPOLL_CTL_DEL, socket->fd, nullptr);
+#endif
+      entries.removeByIndex(index);
+      for (uint i = ready.size(); i > 0; i--) {
+        if (ready[i - 1] != socket) continue;
+        ready.removeByIndex(i - 1);
+        events.removeByIndex(i - 1);
+      }
+      socket->ready_in = false;
+      socket->ready_out = false;
+      socket->pollers--;
+      socket->release();
     }
   };
 
-  auto create_web_socket_message(uint8 opcode) -> WebSocketMessage* {
-    return new WebSocketMessage(opcode);
+  static auto create_poller() -> Poller* {
+    auto poller = new Poller();
+    if (!*poller) {
+      delete poller;
+      return nullptr;
+    }
+    return poller;
   }
 
-  struct WebSocket {
-    Socket* socket;
+  // checks one socket without waiting; unlike select() this is not limited to descriptors below FD_SETSIZE:
+  static auto poll_socket(Socket* sock, short events) -> bool {
+    if (!sock) return false;
+    if (!*sock) return false;
 
-    WebSocket(Socket* socket) : socket(socket) {
-      socket->addRef();
+    pollfd fds{};
+    fds.fd = sock->fd;
+    fds.events = events;
+
+    last_error = 0;
+    int rc = ::poll(&fds, 1, 0);
+    if (rc < 0) {
+      last_error = sock_capture_error();
+      return false;
+    }
+    // a hangup or error is readable, as recv() reports it:
+    return fds.revents & (events | POLLHUP | POLLERR);
+  }
+
+  struct WebSocketMessage {
+    uint8           opcode;
+    vector<uint8_t> bytes;            // the payload, until as_array() moves it into `array`
+    CScriptArray*   array = nullptr;  // the payload, once as_array() has been called
+    string          text;
+
+    WebSocketMessage(uint8 opcode) : opcode(opcode)
+    {
       ref = 1;
     }
-    ~WebSocket() {
-      socket->release();
+    ~WebSocketMessage() {
+      if (array) array->Release();
     }
 
     int ref;
@@ -674,35 +942,101 @@ namespace Net {
         delete this;
     }
 
-    operator bool() { return socket->operator bool(); }
-
-    auto close() -> void {
-      socket->close();
+    // the payload wherever it is kept:
+    auto payload() -> array_view<uint8_t> {
+      if (array) return {(const uint8_t*)array->GetBuffer(), array->GetSize()};
+      return bytes;
     }
 
-    vector<uint8_t> frame;
-    WebSocketMessage *message = nullptr;
+    auto get_opcode() -> uint8 { return opcode; }
+    auto set_opcode(uint8 value) -> void { opcode = value; }
 
-    // attempt to receive data:
-    auto process() -> WebSocketMessage* {
-      if (!*socket) {
-        // TODO: throw exception if socket closed?
-        //printf("[%d] invalid socket!\n", socket->fd);
-        return nullptr;
+    auto get_length() -> uint { return payload().size(); }
+
+    auto at(uint index) -> uint8 {
+      auto data = payload();
+      if (index >= data.size()) {
+        asGetActiveContext()->SetException("Index out of bounds");
+        return 0;
       }
+      return data[index];
+    }
 
-      // Receive data and append to current frame:
-      auto rc = socket->recv_buffer(frame);
-      // No data ready to recv:
-      if (rc == 0) {
-        //printf("[%d] no data\n", socket->fd);
-        return nullptr;
+    auto as_string() -> string* {
+      auto data = payload();
+      text.resize(data.size());
+      memory::copy(text.get(), data.data(), data.size());
+      return &text;
+    }
+
+    // the payload moves into a script array on the first call, and later calls return that same array;
+    // changes made to the array change the payload:
+    auto as_array() -> CScriptArray* {
+      if (!array) {
+        asIScriptContext *ctx = asGetActiveContext();
+        if (!ctx) return nullptr;
+
+        asIScriptEngine* engine = ctx->GetEngine();
+        asITypeInfo* t = engine->GetTypeInfoByDecl("array<uint8>");
+
+        uint64_t size = bytes.size();
+        array = CScriptArray::Create(t, size);
+        if (size > 0) {
+          memory::copy(array->At(0), bytes.data(), size);
+        }
+        bytes.reset();
       }
+      array->AddRef();
+      return array;
+    }
+
+    auto set_payload_as_string(string *s) -> void {
+      if (array) array->Release();
+      array = nullptr;
+      bytes.resize(s->size());
+      memory::copy(bytes.data(), s->data(), s->size());
+    }
+
+    auto set_payload_as_array(CScriptArray *a) -> void {
+      if (array) array->Release();
+      array = nullptr;
+      bytes.resize(a->GetSize());
+      memory::copy(bytes.data(), a->At(0), a->GetSize());
+    }
+  };
+
+  auto create_web_socket_message(uint8 opcode) -> WebSocketMessage* {
+    return new WebSocketMessage(opcode);
+  }
+
+  // XORs a websocket payload with its 4-byte mask key in place, eight bytes at a time:
+  static auto unmask_web_socket_payload(uint8_t* data, uint64_t length, const uint8_t (&mask_key)[4]) -> void {
+    uint8_t key_bytes[8];
+    for (uint k : range(8)) key_bytes[k] = mask_key[k & 3];
+    uint64_t key;
+    memory::copy(&key, key_bytes, 8);
+
+    uint64_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+      uint64_t word;
+      memory::copy(&word, data + i, 8);
+      word ^= key;
+      memory::copy(data + i, &word, 8);
+    }
+    for (; i < length; i++) {
+      data[i] ^= mask_key[i & 3];
+    }
+  }
 
+  // parses the first complete frame at the start of `frame`, removing it and adding its payload to `message`.
+  // the payload is unmasked where it was received; a new message takes it over without copying when the frame is all
+  // that was received. continues through fragments until a frame with FIN set completes the message, and returns it. sets `error` for frames a client
+  // must not send. makes no socket calls and touches no script state, so it is shared by WebSocket and the Worker:
+  static auto decode_web_socket_frame(RecvBuffer& frame, WebSocketMessage*& message, const char*& error) -> WebSocketMessage* {
+    for (;;) {
       // check start of frame:
       uint minsize = 2;
       if (frame.size() < minsize) {
-        //printf"[%d] frame too small (%d) to read opcode and payload length bytes (%d)\n", socket->fd, frame.size(), minsize);
         return nullptr;
       }
 
@@ -723,7 +1057,6 @@ namespace Net {
 
       // need more data?
       if (frame.size() < minsize) {
-        //printf"[%d] frame too small (%d) to read additional payload length bytes (%d)\n", socket->fd, frame.size(), minsize);
         return nullptr;
       }
 
@@ -745,156 +1078,305 @@ namespace Net {
 
       uint8_t mask_key[4] = {0};
 
-      if (mask) {
-        minsize += 4;
-        if (frame.size() < minsize) {
-          //printf"[%d] frame too small (%d) to read mask key bytes (%d)\n", socket->fd, frame.size(), minsize);
-          return nullptr;
-        }
+      if (!mask) {
+        error = "WebSocket frame received from client must be masked";
+        return nullptr;
+      }
 
-        // read mask key:
-        for (unsigned char &mask_byte : mask_key) {
-          mask_byte = frame[i++];
-        }
-        //printf("mask_key is %02x%02x%02x%02x\n", mask_key[0], mask_key[1], mask_key[2], mask_key[3]);
-      } else {
-        //printf("frame is not masked!\n");
-        asGetActiveContext()->SetException("WebSocket frame received from client must be masked", true);
+      minsize += 4;
+      if (frame.size() < minsize) {
         return nullptr;
       }
 
+      // read mask key:
+      for (unsigned char &mask_byte : mask_key) {
+        mask_byte = frame[i++];
+      }
+
       // not enough data in frame yet?
       if (frame.size() - i < len) {
-        //printf"[%d] frame too small (%d) to read full payload (%d)\n", socket->fd, frame.size(), i + len);
         return nullptr;
       }
 
+      if (opcode == 0 && !message) {
+        error = "WebSocket continuation frame received without a message to continue";
+        return nullptr;
+      }
+
+      unmask_web_socket_payload(frame.data() + i, len, mask_key);
+
       // For any opcode but 0 (continuation), start a new message:
       if (opcode != 0) {
-        //printf("new message with opcode = %d\n", opcode);
+        if (message) message->release();
         message = new WebSocketMessage(opcode);
-      }
-
-      // append payload data to message buffer:
-      auto payload = frame.view(i, len);
-      if (mask) {
-        // Unmask the payload with the mask_key and append to message:
-        //printf("append masked payload of size %d\n", payload.size());
-        uint k = 0;
-        for (uint8_t byte : payload) {
-          message->bytes.append(byte ^ mask_key[k]);
-          k = (k + 1) & 3;
-        }
+        message->bytes = frame.take(i, len);
       } else {
-        // Append unmasked payload:
-        //printf("append unmasked payload of size %d\n", payload.size());
-        message->bytes.appends(payload);
+        message->bytes.appends(frame.view(i, len));
+        frame.consume(i + len);
       }
 
-      // clear out already-read data:
-      frame.removeLeft(i + len);
-
-      // if no FIN flag set, wait for more frames:
+      // if no FIN flag set, continue with the next frame:
       if (!fin) {
-        //printf"[%d] FIN not set\n", socket->fd);
-        return nullptr;
+        continue;
       }
 
       // return final message:
-      //printf"[%d] FIN set; returning message\n", socket->fd);
       auto tmp = message;
       message = nullptr;
       return tmp;
     }
+  }
 
-    // send a message:
-    auto send(WebSocketMessage* msg) -> void {
-      vector<uint8_t> outframe;
-
-      uint64_t len = msg->bytes.size();
-      bool fin = true;
-
-      outframe.append((fin << 7) | (msg->opcode & 0x0F));
-
-      bool masked = false;
-      if (len > 65536) {
-        outframe.append((masked << 7) | 127);
-        // send big-endian 64-bit payload length:
-        for (int j = 0; j < 8; j++) {
-          outframe.append((len >> (7-j)*8) & 0xFF);
-        }
-      } else if (len > 125) {
-        outframe.append((masked << 7) | 126);
-        // send big-endian 16-bit payload length:
-        for (int j = 0; j < 2; j++) {
-          outframe.append((len >> (1-j)*8) & 0xFF);
-        }
-      } else {
-        // 7-bit (ish) length:
-        outframe.append((masked << 7) | (len & 0x7F));
-      }
-
-      uint8_t mask_key[4] = {0};
-      if (masked) {
-        // TODO: build and send mask_key
-      }
+  // appends a single unmasked frame holding the whole message to `outframe`:
+  static auto encode_web_socket_frame(vector<uint8_t>& outframe, uint8 opcode, array_view<uint8_t> payload) -> void {
+    uint64_t len = payload.size();
+    bool fin = true;
 
-      // append payload to frame:
-      outframe.appends(msg->bytes);
+    outframe.append((fin << 7) | (opcode & 0x0F));
 
-      // try to send frame:
-      int rc = socket->send_buffer(outframe);
-      if (rc == 0) {
-        // remote peer closed the connection:
-        return;
-      }
-      if (rc < 0) {
-        // TODO: maintain sending state machine
-        //printf"[%d] send() error!\n", socket->fd);
-        return;
+    bool masked = false;
+    if (len > 65535) {
+      outframe.append((masked << 7) | 127);
+      // send big-endian 64-bit payload length:
+      for (int j = 0; j < 8; j++) {
+        outframe.append((len >> (7-j)*8) & 0xFF);
       }
-      if (rc < outframe.size()) {
-        //printf"[%d] send() failed to send entire frame!\n", socket->fd);
-        return;
+    } else if (len > 125) {
+      outframe.append((masked << 7) | 126);
+      // send big-endian 16-bit payload length:
+      for (int j = 0; j < 2; j++) {
+        outframe.append((len >> (1-j)*8) & 0xFF);
       }
+    } else {
+      // 7-bit (ish) length:
+      outframe.append((masked << 7) | (len & 0x7F));
     }
-  };
 
-  // accepts incoming GET requests with websocket upgrade headers and completes the handshake, finally
-  // passing the socket over to WebSocket which handles regular websocket data framing protocol.
-  struct WebSocketHandshaker {
-    Socket* socket = nullptr;
+    // append payload to frame:
+    outframe.appends(payload);
+  }
 
-    string request;
-    vector<string> request_lines;
+  // checks the header lines of a websocket upgrade request. returns true with the `101 Switching Protocols`
+  // response to send if the upgrade is acceptable, otherwise false with the error response to send:
+  static auto web_socket_upgrade(const vector<string>& request_lines, string& response) -> bool {
+    response = "HTTP/1.1 400 Bad Request\r\n\r\n";
 
+    // parse HTTP request:
+    vector<string> line;
     string ws_key;
 
-    enum {
-      EXPECT_GET_REQUEST = 0,
-      PARSE_GET_REQUEST,
-      SEND_HANDSHAKE,
-      OPEN,
-      CLOSED
-    } state;
+    bool req_host = false;
+    bool req_connection = false;
+    bool req_upgrade = false;
+    bool req_ws_key = false;
+    bool req_ws_version = false;
 
-    WebSocketHandshaker(Socket* socket) : socket(socket) {
-      state = EXPECT_GET_REQUEST;
-      ref = 1;
-      socket->addRef();
-    }
-    ~WebSocketHandshaker() {
-      reset();
-      socket->release();
+    // if no lines in request, bail:
+    if (request_lines.size() == 0) {
+      response = "HTTP/1.1 400 Bad Request\r\n\r\nMissing HTTP request line";
+      return false;
     }
 
-    int ref;
-    void addRef() {
-      ref++;
+    // check first line is like `GET ... HTTP/1.1`:
+    line = request_lines[0].split(" ");
+    if (line.size() != 3) {
+      response = "HTTP/1.1 400 Bad Request\r\n\r\nInvalid HTTP request line; must be `[method] [resource] HTTP/1.1`";
+      return false;
     }
-    void release() {
-      if (--ref == 0)
-        delete this;
+    // really want to check if version >= 1.1
+    if (line[2] != "HTTP/1.1") {
+      response = "HTTP/1.1 400 Bad Request\r\n\r\nInvalid HTTP request line; must be HTTP/1.1 version";
+      return false;
+    }
+    if (line[0] != "GET") {
+      response = "HTTP/1.1 405 Method Not Allowed\r\nAllow: GET\r\n\r\n";
+      return false;
+    }
+
+    // check all headers for websocket upgrade requirements:
+    int len = request_lines.size();
+    for (int i = 1; i < len; i++) {
+      auto split = request_lines[i].split(":", 1);
+      auto header = split[0].downcase().strip();
+      auto value = split[1].strip();
+
+      if (header == "host") {
+        req_host = true;
+      } else if (header == "upgrade") {
+        if (!value.contains("websocket")) {
+          response = "HTTP/1.1 400 Bad Request\r\n\r\nUpgrade header must be 'websocket'";
+          return false;
+        }
+        req_upgrade = true;
+      } else if (header == "connection") {
+        if (!value.contains("Upgrade")) {
+          response = "HTTP/1.1 400 Bad Request\r\n\r\nConnection header must be 'Upgrade'";
+          return false;
+        }
+        req_connection = true;
+      } else if (header == "sec-websocket-key") {
+        ws_key = value;
+        // We don't _need_ to do this but it's nice to check:
+        auto decoded = base64_decode(ws_key);
+        if (decoded.size() != 16) {
+          response = "HTTP/1.1 400 Bad Request\r\n\r\nSec-WebSocket-Key header must base64 decode to 16 bytes";
+          return false;
+        }
+        req_ws_key = true;
+      } else if (header == "sec-websocket-version") {
+        if (value != "13") {
+          response = "HTTP/1.1 426 Upgrade Required\r\nSec-WebSocket-Version: 13\r\n\r\nSec-WebSocket-Version header must be '13'";
+          return false;
+        }
+        req_ws_version = true;
+      }
+    }
+
+    // make sure we have the minimal set of HTTP headers for upgrading to websocket:
+    if (!req_host || !req_upgrade || !req_connection || !req_ws_key || !req_ws_version) {
+      vector<string> missing;
+      if (!req_host) missing.append("Host");
+      if (!req_upgrade) missing.append("Upgrade");
+      if (!req_connection) missing.append("Connection");
+      if (!req_ws_key) missing.append("Sec-WebSocket-Key");
+      if (!req_ws_version) missing.append("Sec-WebSocket-Version");
+      response = string{
+        string("HTTP/1.1 426 Upgrade Required\r\n"
+               "Sec-WebSocket-Version: 13\r\n\r\n"
+               "Missing one or more required HTTP headers for WebSocket upgrade: "),
+        missing.merge(", ")
+      };
+      return false;
+    }
+
+    // we have all the required headers and they are valid:
+    auto concat = string{ws_key, string("258EAFA5-E914-47DA-95CA-C5AB0DC85B11")};
+    auto sha1 = nall::Hash::SHA1(concat).output();
+    auto enc = nall::Encode::Base64(sha1);
+    response = string{
+      string(
+        "HTTP/1.1 101 Switching Protocols\r\n"
+        "Connection: Upgrade\r\n"
+        "Upgrade: websocket\r\n"
+        "Sec-WebSocket-Accept: "
+      ),
+      // base64 encoded sha1 hash here
+      enc,
+      string("\r\n\r\n")
+    };
+    return true;
+  }
+
+  struct WebSocket {
+    Socket* socket;
+
+    WebSocket(Socket* socket) : socket(socket) {
+      socket->addRef();
+      ref = 1;
+    }
+    ~WebSocket() {
+      socket->release();
+    }
+
+    int ref;
+    void addRef() {
+      ref++;
+    }
+    void release() {
+      if (--ref == 0)
+        delete this;
+    }
+
+    operator bool() { return socket->operator bool(); }
+
+    auto close() -> void {
+      socket->close();
+    }
+
+    RecvBuffer frame;
+    WebSocketMessage *message = nullptr;
+
+    // attempt to receive data:
+    auto process() -> WebSocketMessage* {
+      if (!*socket) {
+        // TODO: throw exception if socket closed?
+        //printf("[%d] invalid socket!\n", socket->fd);
+        return nullptr;
+      }
+
+      // Receive data and append to current frame; a socket watched by a Poller is only read once it reports data,
+      // but a frame may still hold further messages from an earlier read:
+      if (!socket->pollers || socket->ready_in) {
+        socket->recv_buffer(frame);
+        socket->ready_in = false;
+      }
+
+      const char* error = nullptr;
+      auto tmp = decode_web_socket_frame(frame, message, error);
+      if (error) {
+        asGetActiveContext()->SetException(error, true);
+      }
+      return tmp;
+    }
+
+    // send a message:
+    auto send(WebSocketMessage* msg) -> void {
+      vector<uint8_t> outframe;
+      encode_web_socket_frame(outframe, msg->opcode, msg->payload());
+
+      // try to send frame:
+      int rc = socket->send_buffer(outframe);
+      if (rc == 0) {
+        // remote peer closed the connection:
+        return;
+      }
+      if (rc < 0) {
+        // TODO: maintain sending state machine
+        //printf"[%d] send() error!\n", socket->fd);
+        return;
+      }
+      if (rc < outframe.size()) {
+        //printf"[%d] send() failed to send entire frame!\n", socket->fd);
+        return;
+      }
+    }
+  };
+
+  // accepts incoming GET requests with websocket upgrade headers and completes the handshake, finally
+  // passing the socket over to WebSocket which handles regular websocket data framing protocol.
+  struct WebSocketHandshaker {
+    Socket* socket = nullptr;
+
+    string request;
+    vector<string> request_lines;
+
+    string response;
+
+    enum {
+      EXPECT_GET_REQUEST = 0,
+      PARSE_GET_REQUEST,
+      SEND_HANDSHAKE,
+      OPEN,
+      CLOSED
+    } state;
+
+    WebSocketHandshaker(Socket* socket) : socket(socket) {
+      state = EXPECT_GET_REQUEST;
+      ref = 1;
+      socket->addRef();
+    }
+    ~WebSocketHandshaker() {
+      reset();
+      socket->release();
+    }
+
+    int ref;
+    void addRef() {
+      ref++;
+    }
+    void release() {
+      if (--ref == 0)
+        delete this;
     }
 
     operator bool() { return *socket; }
@@ -906,7 +1388,7 @@ namespace Net {
     auto reset() -> void {
       request.reset();
       request_lines.reset();
-      ws_key.reset();
+      response.reset();
     }
 
     auto handshake() -> WebSocket* {
@@ -943,127 +1425,18 @@ namespace Net {
       }
 
       if (state == PARSE_GET_REQUEST) {
-        string response = "HTTP/1.1 400 Bad Request\r\n\r\n";
-
-        // parse HTTP request:
-        vector<string> headers;
-        vector<string> line;
-        int len;
-
-        bool req_host = false;
-        bool req_connection = false;
-        bool req_upgrade = false;
-        bool req_ws_key = false;
-        bool req_ws_version = false;
-
-        // if no lines in request, bail:
-        if (request_lines.size() == 0) {
-          response = "HTTP/1.1 400 Bad Request\r\n\r\nMissing HTTP request line";
-          goto bad_request;
-        }
-
-        // check first line is like `GET ... HTTP/1.1`:
-        line = request_lines[0].split(" ");
-        if (line.size() != 3) {
-          response = "HTTP/1.1 400 Bad Request\r\n\r\nInvalid HTTP request line; must be `[method] [resource] HTTP/1.1`";
-          goto bad_request;
-        }
-        // really want to check if version >= 1.1
-        if (line[2] != "HTTP/1.1") {
-          response = "HTTP/1.1 400 Bad Request\r\n\r\nInvalid HTTP request line; must be HTTP/1.1 version";
-          goto bad_request;
-        }
-        if (line[0] != "GET") {
-          response = "HTTP/1.1 405 Method Not Allowed\r\nAllow: GET\r\n\r\n";
-          goto bad_request;
-        }
-
-        // check all headers for websocket upgrade requirements:
-        len = request_lines.size();
-        for (int i = 1; i < len; i++) {
-          auto split = request_lines[i].split(":", 1);
-          auto header = split[0].downcase().strip();
-          auto value = split[1].strip();
-
-          if (header == "host") {
-            req_host = true;
-          } else if (header == "upgrade") {
-            if (!value.contains("websocket")) {
-              response = "HTTP/1.1 400 Bad Request\r\n\r\nUpgrade header must be 'websocket'";
-              goto bad_request;
-            }
-            req_upgrade = true;
-          } else if (header == "connection") {
-            if (!value.contains("Upgrade")) {
-              response = "HTTP/1.1 400 Bad Request\r\n\r\nConnection header must be 'Upgrade'";
-              goto bad_request;
-            }
-            req_connection = true;
-          } else if (header == "sec-websocket-key") {
-            ws_key = value;
-            // We don't _need_ to do this but it's nice to check:
-            auto decoded = base64_decode(ws_key);
-            if (decoded.size() != 16) {
-              response = "HTTP/1.1 400 Bad Request\r\n\r\nSec-WebSocket-Key header must base64 decode to 16 bytes";
-              goto bad_request;
-            }
-            req_ws_key = true;
-          } else if (header == "sec-websocket-version") {
-            if (value != "13") {
-              response = "HTTP/1.1 426 Upgrade Required\r\nSec-WebSocket-Version: 13\r\n\r\nSec-WebSocket-Version header must be '13'";
-              goto response_sent;
-            }
-            req_ws_version = true;
-          }
-        }
-
-        // make sure we have the minimal set of HTTP headers for upgrading to websocket:
-        if (!req_host || !req_upgrade || !req_connection || !req_ws_key || !req_ws_version) {
-          vector<string> missing;
-          if (!req_host) missing.append("Host");
-          if (!req_upgrade) missing.append("Upgrade");
-          if (!req_connection) missing.append("Connection");
-          if (!req_ws_key) missing.append("Sec-WebSocket-Key");
-          if (!req_ws_version) missing.append("Sec-WebSocket-Version");
-          response = string{
-            string("HTTP/1.1 426 Upgrade Required\r\n"
-                   "Sec-WebSocket-Version: 13\r\n\r\n"
-                   "Missing one or more required HTTP headers for WebSocket upgrade: "),
-            missing.merge(", ")
-          };
-          goto bad_request;
+        if (!web_socket_upgrade(request_lines, response)) {
+          socket->send_buffer(response);
+          reset();
+          state = EXPECT_GET_REQUEST;
+          return nullptr;
         }
 
-        // we have all the required headers and they are valid:
-        goto next_state;
-
-        bad_request:
-        socket->send_buffer(response);
-        response_sent:
-        reset();
-        state = EXPECT_GET_REQUEST;
-        return nullptr;
-
-        next_state:
         state = SEND_HANDSHAKE;
       }
 
       if (state == SEND_HANDSHAKE) {
-        auto concat = string{ws_key, string("258EAFA5-E914-47DA-95CA-C5AB0DC85B11")};
-        auto sha1 = nall::Hash::SHA1(concat).output();
-        auto enc = nall::Encode::Base64(sha1);
-        auto buf = string{
-          string(
-            "HTTP/1.1 101 Switching Protocols\r\n"
-            "Connection: Upgrade\r\n"
-            "Upgrade: websocket\r\n"
-            "Sec-WebSocket-Accept: "
-          ),
-          // base64 encoded sha1 hash here
-          enc,
-          string("\r\n\r\n")
-        };
-        socket->send_buffer(buf);
+        socket->send_buffer(response);
 
         state = OPEN;
         return new WebSocket(socket);
@@ -1077,6 +1450,45 @@ namespace Net {
     return new WebSocketHandshaker(socket);
   }
 
+  // splits an absolute `ws://host:port/path...` uri into its host, port and resource; raises a script exception if invalid:
+  static auto split_web_socket_uri(string uri, string& host, string& port, string& resource) -> bool {
+    // use a default uri:
+    if (!uri) uri = "ws://localhost:8080";
+
+    // Split the absolute URI `ws://host:port/path.../path...` into `ws:` and `host:port/path.../path...`
+    auto scheme_rest = uri.split("//", 1);
+    if (scheme_rest.size() == 0) {
+      asGetActiveContext()->SetException("uri must be an absolute URI");
+      return false;
+    }
+    string scheme = scheme_rest[0];
+    if (scheme != "ws:") {
+      asGetActiveContext()->SetException("uri scheme must be `ws:`");
+      return false;
+    }
+
+    // Split the remaining `host:port/path.../path...` by the first '/':
+    auto rest = scheme_rest[1];
+    auto host_port_path = rest.split("/", 1);
+    if (host_port_path.size() == 0) host_port_path.append(rest);
+
+    // TODO: accommodate IPv6 addresses (e.g. `[::1]`)
+    host = host_port_path[0];
+    auto host_port = host_port_path[0].split(":");
+    if (host_port.size() == 2) {
+      host = host_port[0];
+      port = host_port[1];
+    } else {
+      port = "80";
+    }
+
+    resource = "/";
+    if (host_port_path.size() == 2) {
+      resource = string{"/", host_port_path[1]};
+    }
+    return true;
+  }
+
   struct WebSocketServer {
     Socket* socket = nullptr;
     string host;
@@ -1106,40 +1518,7 @@ namespace Net {
         return;
       }
 
-      // use a default uri:
-      if (!uri) uri = "ws://localhost:8080";
-
-      // Split the absolute URI `ws://host:port/path.../path...` into `ws:` and `host:port/path.../path...`
-      auto scheme_rest = uri.split("//", 1);
-      if (scheme_rest.size() == 0) {
-        asGetActiveContext()->SetException("uri must be an absolute URI");
-        return;
-      }
-      string scheme = scheme_rest[0];
-      if (scheme != "ws:") {
-        asGetActiveContext()->SetException("uri scheme must be `ws:`");
-        return;
-      }
-
-      // Split the remaining `host:port/path.../path...` by the first '/':
-      auto rest = scheme_rest[1];
-      auto host_port_path = rest.split("/", 1);
-      if (host_port_path.size() == 0) host_port_path.append(rest);
-
-      // TODO: accommodate IPv6 addresses (e.g. `[::1]`)
-      host = host_port_path[0];
-      auto host_port = host_port_path[0].split(":");
-      if (host_port.size() == 2) {
-        host = host_port[0];
-        port = host_port[1];
-      } else {
-        port = "80";
-      }
-
-      resource = "/";
-      if (host_port_path.size() == 2) {
-        resource = string{"/", host_port_path[1]};
-      }
+      if (!split_web_socket_uri(uri, host, port, resource)) return;
 
       // resolve listening address:
       auto addr = resolve_tcp(&host, &port);
@@ -1156,12 +1535,14 @@ namespace Net {
       // start listening for connections:
       if (socket->bind(addr) < 0) return;
       if (socket->listen(32) < 0) return;
+      if (!poller || !poller.add(socket, Poller::Readable)) return;
 
       // create `array<WebSocket@>` for clients:
       clients = CScriptArray::Create(typeInfo);
       valid = true;
     }
     ~WebSocketServer() {
+      poller.reset();
       if (socket) {
         delete socket;
         socket = nullptr;
@@ -1183,13 +1564,22 @@ namespace Net {
     vector<WebSocketHandshaker*> handshakers;
     CScriptArray* clients;
 
+    // watches the listening socket, the connections being handshaken and the connected clients:
+    Poller poller;
+
     auto process() -> int {
       int count = 0;
 
+      // find out which sockets have anything to do with a single call:
+      poller.poll();
+
       // accept new connections:
-      Socket* accepted = nullptr;
-      while ((accepted = socket->accept()) != nullptr) {
-        handshakers.append(new WebSocketHandshaker(accepted));
+      if (socket->ready_in) {
+        Socket* accepted = nullptr;
+        while ((accepted = socket->accept()) != nullptr) {
+          handshakers.append(new WebSocketHandshaker(accepted));
+          poller.add(accepted, Poller::Readable);
+        }
       }
 
       // handle requests for each open connection:
@@ -1200,6 +1590,9 @@ namespace Net {
           continue;
         }
 
+        // nothing received yet:
+        if (!(*it)->socket->ready_in) continue;
+
         // advance the websocket handshake / upgrade process from HTTP requests to WebSockets:
         WebSocket* ws = nullptr;
         // TODO: accept only resource path
@@ -1225,6 +1618,606 @@ namespace Net {
     }
     return server;
   }
+
+  // single-producer/single-consumer ring of pointers. push() and pop() never block or make syscalls, so the
+  // emulation thread and the network Worker can hand objects to each other every frame:
+  template<typename T, uint Size>
+  struct Ring {
+    static_assert((Size & (Size - 1)) == 0, "Ring size must be a power of two");
+
+    // producer only; returns false if the ring is full:
+    auto push(T* item) -> bool {
+      uint t = tail.load(std::memory_order_relaxed);
+      if (t - head.load(std::memory_order_acquire) == Size) return false;
+      slots[t & (Size - 1)] = item;
+      tail.store(t + 1, std::memory_order_release);
+      return true;
+    }
+
+    // consumer only; returns nullptr if the ring is empty:
+    auto pop() -> T* {
+      uint h = head.load(std::memory_order_relaxed);
+      if (h == tail.load(std::memory_order_acquire)) return nullptr;
+      auto item = slots[h & (Size - 1)];
+      head.store(h + 1, std::memory_order_release);
+      return item;
+    }
+
+    auto empty() const -> bool {
+      return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+  private:
+    T* slots[Size];
+    alignas(64) std::atomic<uint> head{0};  //next slot to pop
+    alignas(64) std::atomic<uint> tail{0};  //next slot to push
+  };
+
+  // something that happened on one of a Worker's channels, handed to the script by Worker::poll():
+  struct WorkerEvent {
+    enum : uint {
+      Opened,    // connected, listening, or a websocket client completed its handshake
+      Received,  // a whole message arrived
+      Closed,    // closed by either side; `error` holds the socket error that closed it, if any
+    };
+
+    uint kind;
+    uint channel;
+    uint server;  // the listening channel that accepted a websocket client, otherwise 0
+    int  error = 0;
+    WebSocketMessage* message = nullptr;
+
+    WorkerEvent(uint kind, uint channel, uint server = 0) : kind(kind), channel(channel), server(server) {
+      ref = 1;
+    }
+    ~WorkerEvent() {
+      if (message) message->release();
+    }
+
+    int ref;
+    void addRef() {
+      ref++;
+    }
+    void release() {
+      if (--ref == 0)
+        delete this;
+    }
+
+    auto get_message() -> WebSocketMessage* {
+      if (message) message->addRef();
+      return message;
+    }
+
+    auto get_error_text() -> string {
+      if (!error) return "";
+      string s = {sock_error_string(error)};
+      s.trimRight("\r\n ");
+      return s;
+    }
+  };
+
+  // something the script asked a Worker to do:
+  struct WorkerCommand {
+    enum : uint { Add, Send, Close };
+
+    uint kind;
+    uint channel;
+    uint type = 0;  // Add: the Worker channel type
+    int  fd = -1;   // Add: the socket handed over to the worker
+    uint8 opcode = 0;
+    vector<uint8_t> bytes;
+
+    WorkerCommand(uint kind, uint channel) : kind(kind), channel(channel) {}
+  };
+
+  // owns its sockets on a background thread which does every read, write and websocket framing for them. the script
+  // exchanges whole messages with it through two lock-free rings that it drains once per frame, so a slow peer or a
+  // burst of packets never delays the emulated frame, and polling or sending makes no syscalls on the emulation thread
+  // (a send wakes the worker only if it is idle). sockets are set up by the script and then known by channel number;
+  // websocket clients accepted by a listening channel are numbered by the worker and announced by an Opened event.
+  struct Worker {
+    enum : uint {
+      Listener,         // accepts websocket clients
+      WebSocketClient,  // handshake, then one message per websocket message
+      Stream,           // TCP; one message per read, as the byte stream has no framing of its own
+      Datagram,         // connected UDP; one message per datagram
+    };
+
+    Worker() {
+      ref = 1;
+
+      // a loopback UDP socket connected to itself wakes the worker from poll() on every platform:
+      int fd = ::socket(AF_INET, SOCK_DGRAM, 0); last_error_location = LOCATION " socket";
+      last_error = 0;
+      if (fd < 0) {
+        last_error = sock_capture_error();
+        exception_thrown();
+        return;
+      }
+      sockaddr_in address{};
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      socklen_t length = sizeof(address);
+      if (::bind(fd, (sockaddr*)&address, length) < 0
+       || ::getsockname(fd, (sockaddr*)&address, &length) < 0
+       || ::connect(fd, (sockaddr*)&address, length) < 0
+       || !set_nonblocking(fd)
+      ) {
+        last_error_location = LOCATION " wake socket";
+        last_error = sock_capture_error();
+        close_socket(fd);
+        exception_thrown();
+        return;
+      }
+      wake_fd = fd;
+
+      thread = std::thread{[this] { run(); }};
+    }
+
+    ~Worker() {
+      if (thread.joinable()) {
+        quit.store(true);
+        wake();
+        thread.join();
+      }
+
+      // discard whatever the other side never picked up:
+      while (auto event = events.pop()) event->release();
+      while (auto command = commands.pop()) {
+        if (command->fd >= 0) close_socket(command->fd);
+        delete command;
+      }
+      if (wake_fd >= 0) close_socket(wake_fd);
+      wake_fd = -1;
+    }
+
+    int ref;
+    void addRef() {
+      ref++;
+    }
+    void release() {
+      if (--ref == 0)
+        delete this;
+    }
+
+    operator bool() { return wake_fd >= 0; }
+
+    // start accepting websocket clients on a `ws://host:port/path` uri; returns the listening channel or -1:
+    auto listen_web_socket(string uri) -> int {
+      string host, port, resource;
+      if (!split_web_socket_uri(uri, host, port, resource)) return -1;
+      return listen_web_socket(host, port);
+    }
+
+    // the same for callers without a script context, which cannot report a malformed uri:
+    auto listen_web_socket(const string& host, const string& port) -> int {
+      auto addr = resolve_tcp(&host, &port);
+      if (!addr) return -1;
+
+      Socket socket(addr->info->ai_family, addr->info->ai_socktype, addr->info->ai_protocol);
+      bool listening = socket && socket.bind(addr) >= 0 && socket.listen(32) >= 0;
+      delete addr;
+      if (!listening) {
+        socket.closeNoError();
+        return -1;
+      }
+      return add(Listener, socket.detach());
+    }
+
+    // connect to a TCP or UDP address; returns the channel, which reports Opened once connected, or -1:
+    auto connect(const Address* addr) -> int {
+      if (!addr || !addr->info) return -1;
+
+      Socket socket(addr->info->ai_family, addr->info->ai_socktype, addr->info->ai_protocol);
+      if (!socket) return -1;
+      if (socket.connect(addr) < 0) {
+        // non-blocking TCP sockets finish connecting on the worker:
+#if !defined(PLATFORM_WINDOWS)
+        if (last_error != EINPROGRESS) {
+#else
+        if (last_error != WSAEWOULDBLOCK) {
+#endif
+          socket.closeNoError();
+          return -1;
+        }
+        last_error = 0;
+      }
+      return add(addr->info->ai_socktype == SOCK_DGRAM ? Datagram : Stream, socket.detach());
+    }
+
+    // queue a message to be sent on a channel; returns false if the queue is full:
+    auto send(int channel, WebSocketMessage* msg) -> bool {
+      if (!msg) return false;
+
+      vector<uint8_t> bytes;
+      bytes.appends(msg->payload());
+      return send(channel, msg->opcode, move(bytes));
+    }
+
+    // the same for native callers, whose payload is handed to the worker without another copy:
+    auto send(int channel, uint8 opcode, vector<uint8_t>&& bytes) -> bool {
+      if (channel <= 0) return false;
+
+      auto command = new WorkerCommand(WorkerCommand::Send, channel);
+      command->opcode = opcode;
+      command->bytes = move(bytes);
+      if (!submit(command)) {
+        delete command;
+        return false;
+      }
+      return true;
+    }
+
+    // close a channel once everything queued on it is sent; a Closed event follows:
+    auto close(int channel) -> bool {
+      if (channel <= 0) return false;
+
+      auto command = new WorkerCommand(WorkerCommand::Close, channel);
+      if (!submit(command)) {
+        delete command;
+        return false;
+      }
+      return true;
+    }
+
+    // take the next event, or nullptr if there is none yet:
+    auto poll() -> WorkerEvent* {
+      return events.pop();
+    }
+
+  private:
+    static constexpr uint QueueSize = 4096;
+
+    Ring<WorkerCommand, QueueSize> commands;  // script -> worker
+    Ring<WorkerEvent, QueueSize> events;      // worker -> script
+
+    std::atomic<uint> next_channel{1};
+    std::atomic<bool> sleeping{false};
+    std::atomic<bool> quit{false};
+    int wake_fd = -1;
+    std::thread thread;
+
+    auto add(uint type, int fd) -> int {
+      auto command = new WorkerCommand(WorkerCommand::Add, next_channel++);
+      command->type = type;
+      command->fd = fd;
+      uint channel = command->channel;
+      if (!submit(command)) {
+        close_socket(fd);
+        delete command;
+        return -1;
+      }
+      return channel;
+    }
+
+    auto submit(WorkerCommand* command) -> bool {
+      if (!commands.push(command)) return false;
+      // a busy worker picks the command up on its next pass; only one waiting in poll() needs waking:
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (sleeping.exchange(false)) wake();
+      return true;
+    }
+
+    auto wake() -> void {
+      uint8_t byte = 0;
+      ::send(wake_fd, SEND_BUF_CAST(&byte), 1, MSG_NOSIGNAL);
+    }
+
+    // the sockets below belong to the worker thread, which must not touch last_error or the script context:
+
+    static auto would_block(int error) -> bool {
+#if !defined(PLATFORM_WINDOWS)
+      return error == EWOULDBLOCK || error == EAGAIN || error == EINTR;
+#else
+      return error == WSAEWOULDBLOCK;
+#endif
+    }
+
+    static auto set_nonblocking(int fd) -> bool {
+      int yes = 1;
+#if !defined(PLATFORM_WINDOWS)
+      return ioctl(fd, FIONBIO, &yes) >= 0;
+#else
+      return ioctlsocket(fd, FIONBIO, (u_long *)&yes) >= 0;
+#endif
+    }
+
+    static auto close_socket(int fd) -> void {
+#if !defined(PLATFORM_WINDOWS)
+      ::close(fd);
+#else
+      ::closesocket(fd);
+#endif
+    }
+
+    struct Channel {
+      uint id;
+      uint server = 0;
+      uint type;
+      int  fd;
+      bool connecting = false;  // TCP connect() still in progress
+      bool open = false;        // websocket handshake completed
+      bool closing = false;     // close once output is sent
+      RecvBuffer input;         // websocket bytes received but not yet parsed
+      vector<uint8_t> output;   // stream bytes waiting to be sent
+      WebSocketMessage* message = nullptr;  // websocket message still waiting for its FIN frame
+
+      ~Channel() {
+        if (message) message->release();
+      }
+    };
+
+    vector<Channel*> channels;
+    vector<WorkerEvent*> backlog;  // events waiting for room in the ring
+    uint8_t buffer[65536];
+
+    auto run() -> void {
+      vector<pollfd> fds;
+      vector<Channel*> polled;
+
+      while (!quit.load()) {
+        execute();
+        deliver();
+
+        // the wake socket comes first, then every channel:
+        polled = channels;
+        fds.resize(1 + polled.size());
+        fds[0].fd = wake_fd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        for (uint i : range(polled.size())) {
+          auto channel = polled[i];
+          short interest = 0;
+          // stop reading while the script is behind, so events cannot pile up without bound:
+          if (!backlog) interest |= POLLIN;
+          if (channel->connecting || channel->output) interest |= POLLOUT;
+          // poll() reports hangups and errors even without interest, and a channel behind the backlog
+          // would not read or drop on them; it is left out until the backlog drains:
+          fds[1 + i].fd = interest ? channel->fd : -1;
+          fds[1 + i].events = interest;
+          fds[1 + i].revents = 0;
+        }
+
+        sleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!commands.empty() || quit.load()) {
+          sleeping.store(false);
+          continue;
+        }
+        // the script drains events once per frame, so retry a backlog soon:
+        int rc = ::poll(fds.data(), fds.size(), backlog ? 1 : -1);
+        sleeping.store(false);
+        if (rc <= 0) continue;
+
+        if (fds[0].revents) {
+          while (::recv(wake_fd, RECV_BUF_CAST(buffer), sizeof(buffer), 0) > 0);
+        }
+
+        for (uint i : range(polled.size())) {
+          auto channel = polled[i];
+          auto revents = fds[1 + i].revents;
+          if (!revents || channel->fd < 0) continue;
+
+          if (channel->connecting) {
+            connected(channel);
+            continue;
+          }
+          if (revents & (POLLIN | POLLHUP | POLLERR | POLLNVAL)) receive(channel);
+          if (channel->fd >= 0 && (revents & POLLOUT)) transmit(channel);
+        }
+
+        sweep();
+      }
+
+      for (auto channel : channels) {
+        if (channel->fd >= 0) close_socket(channel->fd);
+        delete channel;
+      }
+      channels.reset();
+      for (auto event : backlog) event->release();
+      backlog.reset();
+    }
+
+    auto find(uint id) -> Channel* {
+      for (auto channel : channels) {
+        if (channel->id == id && channel->fd >= 0) return channel;
+      }
+      return nullptr;
+    }
+
+    auto emit(WorkerEvent* event) -> void {
+      if (backlog || !events.push(event)) backlog.append(event);
+    }
+
+    auto deliver() -> void {
+      uint count = 0;
+      while (count < backlog.size() && events.push(backlog[count])) count++;
+      backlog.removeLeft(count);
+    }
+
+    // closes the channel; it is removed from the list by the next sweep():
+    auto drop(Channel* channel, int error) -> void {
+      close_socket(channel->fd);
+      channel->fd = -1;
+
+      // websocket clients are only known to the script once their handshake completes:
+      if (channel->type == WebSocketClient && !channel->open) return;
+      auto event = new WorkerEvent(WorkerEvent::Closed, channel->id, channel->server);
+      event->error = error;
+      emit(event);
+    }
+
+    auto sweep() -> void {
+      for (uint i = channels.size(); i > 0; i--) {
+        if (channels[i - 1]->fd >= 0) continue;
+        delete channels[i - 1];
+        channels.removeByIndex(i - 1);
+      }
+    }
+
+    auto execute() -> void {
+      while (auto command = commands.pop()) {
+        if (command->kind == WorkerCommand::Add) {
+          auto channel = new Channel;
+          channel->id = command->channel;
+          channel->type = command->type;
+          channel->fd = command->fd;
+          channel->connecting = command->type == Stream;
+          channels.append(channel);
+          if (!channel->connecting) emit(new WorkerEvent(WorkerEvent::Opened, channel->id));
+        } else if (auto channel = find(command->channel)) {
+          if (command->kind == WorkerCommand::Send && !channel->closing) {
+            if (channel->type == Datagram) {
+              // datagrams are sent whole or not at all, as UDP may drop them anyway:
+              ::send(channel->fd, SEND_BUF_CAST(command->bytes.data()), command->bytes.size(), MSG_NOSIGNAL);
+            } else if (channel->type == Stream) {
+              channel->output.appends(command->bytes);
+            } else if (channel->type == WebSocketClient && channel->open) {
+              encode_web_socket_frame(channel->output, command->opcode, command->bytes);
+            }
+          } else if (command->kind == WorkerCommand::Close) {
+            channel->closing = true;
+          }
+          if (!channel->connecting) transmit(channel);
+        }
+        delete command;
+      }
+      sweep();
+    }
+
+    auto connected(Channel* channel) -> void {
+      int error = 0;
+      socklen_t length = sizeof(error);
+      ::getsockopt(channel->fd, SOL_SOCKET, SO_ERROR, (char*)&error, &length);
+      if (error) return drop(channel, error);
+
+      channel->connecting = false;
+      emit(new WorkerEvent(WorkerEvent::Opened, channel->id));
+      if (channel->output || channel->closing) transmit(channel);
+    }
+
+    auto transmit(Channel* channel) -> void {
+      while (channel->output) {
+        int rc = ::send(channel->fd, SEND_BUF_CAST(channel->output.data()), channel->output.size(), MSG_NOSIGNAL);
+        if (rc < 0) {
+          int error = sock_capture_error();
+          if (would_block(error)) return;
+          return drop(channel, error);
+        }
+        channel->output.removeLeft(rc);
+      }
+      if (channel->closing) drop(channel, 0);
+    }
+
+    auto receive(Channel* channel) -> void {
+      if (channel->type == Listener) return accept(channel);
+
+      // reading stops while events wait for room in the ring; poll() asks for more once the backlog drains:
+      while (!backlog) {
+        // a request whose headers do not fit in 64 KiB is tossed out before anything more is read:
+        if (channel->type == WebSocketClient && !channel->open && channel->input.size() >= 65536) {
+          return drop(channel, 0);
+        }
+
+        // websocket bytes are read straight into the channel's buffer and parsed there:
+        auto space = channel->type == WebSocketClient ? channel->input.space(4096) : array_span<uint8_t>{buffer, sizeof(buffer)};
+        int rc = ::recv(channel->fd, RECV_BUF_CAST(space.data()), space.size(), 0);
+        if (rc < 0) {
+          int error = sock_capture_error();
+          if (would_block(error)) break;
+          // a refused datagram costs one recv() error but does not close the socket:
+          if (channel->type == Datagram) break;
+          return drop(channel, error);
+        }
+        if (rc == 0 && channel->type != Datagram) {
+          // remote peer closed the connection:
+          return drop(channel, 0);
+        }
+
+        if (channel->type == WebSocketClient) {
+          channel->input.commit(rc);
+          parse(channel);
+          if (channel->fd < 0) return;
+          continue;
+        }
+        auto event = new WorkerEvent(WorkerEvent::Received, channel->id);
+        event->message = new WebSocketMessage(2);
+        event->message->bytes.appends({buffer, (uint)rc});
+        emit(event);
+      }
+    }
+
+    auto accept(Channel* listener) -> void {
+      for (;;) {
+        int fd = ::accept(listener->fd, nullptr, nullptr);
+        if (fd < 0) return;
+        if (!set_nonblocking(fd)) {
+          close_socket(fd);
+          continue;
+        }
+
+        auto channel = new Channel;
+        channel->id = next_channel++;
+        channel->server = listener->id;
+        channel->type = WebSocketClient;
+        channel->fd = fd;
+        channels.append(channel);
+      }
+    }
+
+    auto parse(Channel* channel) -> void {
+      if (!channel->open) {
+        // wait for the end of the request headers:
+        auto& input = channel->input;
+        maybe<uint> end;
+        for (uint i = 3; i < input.size(); i++) {
+          if (input[i - 3] == '\r' && input[i - 2] == '\n' && input[i - 1] == '\r' && input[i] == '\n') {
+            end = i - 3;
+            break;
+          }
+        }
+        if (!end) return;
+
+        string request;
+        request.resize(*end);
+        memory::copy(request.get(), input.data(), *end);
+        input.consume(*end + 4);
+
+        string response;
+        bool upgraded = web_socket_upgrade(request.split("\r\n"), response);
+        channel->output.appends({(const uint8_t*)response.data(), (uint)response.size()});
+        if (!upgraded) {
+          channel->closing = true;
+          return transmit(channel);
+        }
+
+        channel->open = true;
+        emit(new WorkerEvent(WorkerEvent::Opened, channel->id, channel->server));
+        transmit(channel);
+        if (channel->fd < 0) return;
+      }
+
+      for (;;) {
+        const char* error = nullptr;
+        auto message = decode_web_socket_frame(channel->input, channel->message, error);
+        if (error) return drop(channel, 0);
+        if (!message) return;
+
+        auto event = new WorkerEvent(WorkerEvent::Received, channel->id, channel->server);
+        event->message = message;
+        emit(event);
+      }
+    }
+  };
+
+  static auto create_worker() -> Worker* {
+    auto worker = new Worker();
+    if (!*worker) {
+      delete worker;
+      return nullptr;
+    }
+    return worker;
+  }
 }
 
 auto RegisterNet(asIScriptEngine *e) -> void {
@@ -1273,42 +2266,42 @@ auto RegisterNet(asIScriptEngine *e) -> void {
     ([](Net::Socket& self, int offs, int size, CScriptArray* buffer, const Net::Address* addr) { return self.sendto(offs, size, buffer, addr); })
   );
 
-  r = e->RegisterGlobalFunction("bool is_writable(const Socket &in)", asFUNCTION(+([](Net::Socket *sock) -> bool {
-    if (!sock) return false;
-    if (!*sock) return false;
-
-    timeval zero {0, 0};
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(sock->fd, &fds);
+  REG_LAMBDA(Socket, "bool get_ready_in() property",  ([](Net::Socket& self) { return self.ready_in; }));
+  REG_LAMBDA(Socket, "bool get_ready_out() property", ([](Net::Socket& self) { return self.ready_out; }));
 
-    Net::last_error = 0;
-    int rc = select(FD_SETSIZE, NULL, &fds, NULL, &zero);
-    if (rc < 0) {
-      Net::last_error = sock_capture_error();
-      return false;
-    }
-    return (bool) FD_ISSET(sock->fd, &fds);
+  r = e->RegisterGlobalFunction("bool is_writable(const Socket &in)", asFUNCTION(+([](Net::Socket *sock) -> bool {
+    return Net::poll_socket(sock, POLLOUT);
   })), asCALL_CDECL); assert( r >= 0 );
 
   r = e->RegisterGlobalFunction("bool is_readable(const Socket &in)", asFUNCTION(+([](Net::Socket *sock) -> bool {
-    if (!sock) return false;
-    if (!*sock) return false;
-
-    timeval zero {0, 0};
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(sock->fd, &fds);
-
-    Net::last_error = 0;
-    int rc = select(FD_SETSIZE, &fds, NULL, NULL, &zero);
-    if (rc < 0) {
-      Net::last_error = sock_capture_error();
-      return false;
-    }
-    return (bool) FD_ISSET(sock->fd, &fds);
+    return Net::poll_socket(sock, POLLIN);
   })), asCALL_CDECL); assert( r >= 0 );
 
+  // Poller type; watches many sockets with one call per frame:
+  r = e->RegisterEnum("poll"); assert(r >= 0);
+  r = e->RegisterEnumValue("poll", "readable", Net::Poller::Readable); assert(r >= 0);
+  r = e->RegisterEnumValue("poll", "writable", Net::Poller::Writable); assert(r >= 0);
+  r = e->RegisterEnumValue("poll", "closed", Net::Poller::Closed); assert(r >= 0);
+
+  r = e->RegisterObjectType("Poller", 0, asOBJ_REF); assert(r >= 0);
+  r = e->RegisterObjectBehaviour("Poller", asBEHAVE_FACTORY, "Poller@ f()", asFUNCTION(Net::create_poller), asCALL_CDECL); assert(r >= 0);
+  r = e->RegisterObjectBehaviour("Poller", asBEHAVE_ADDREF, "void f()", asMETHOD(Net::Poller, addRef), asCALL_THISCALL); assert( r >= 0 );
+  r = e->RegisterObjectBehaviour("Poller", asBEHAVE_RELEASE, "void f()", asMETHOD(Net::Poller, release), asCALL_THISCALL); assert( r >= 0 );
+  REG_LAMBDA(Poller, "bool add(Socket@+ socket, uint interest = net::readable)",
+    ([](Net::Poller& self, Net::Socket* socket, uint interest) { return self.add(socket, interest); })
+  );
+  REG_LAMBDA(Poller, "bool remove(Socket@+ socket)", ([](Net::Poller& self, Net::Socket* socket) { return self.remove(socket); }));
+  REG_LAMBDA(Poller, "void reset()",                ([](Net::Poller& self) { self.reset(); }));
+  REG_LAMBDA(Poller, "int poll(int timeout = 0)",   ([](Net::Poller& self, int timeout) { return self.poll(timeout); }));
+  REG_LAMBDA(Poller, "uint get_count() property",   ([](Net::Poller& self) { return self.get_count(); }));
+  REG_LAMBDA(Poller, "uint get_ready_count() property", ([](Net::Poller& self) { return self.get_ready_count(); }));
+  REG_LAMBDA(Poller, "Socket@ get_ready(uint i) property", ([](Net::Poller& self, uint i) -> Net::Socket* {
+    auto socket = self.get_ready(i);
+    if (socket) socket->addRef();
+    return socket;
+  }));
+  REG_LAMBDA(Poller, "uint get_events(uint i) property", ([](Net::Poller& self, uint i) { return self.get_events(i); }));
+
   r = e->RegisterObjectType("WebSocketMessage", 0, asOBJ_REF); assert(r >= 0);
   r = e->RegisterObjectBehaviour("WebSocketMessage", asBEHAVE_FACTORY, "WebSocketMessage@ f(uint8 opcode)", asFUNCTION(Net::create_web_socket_message), asCALL_CDECL); assert(r >= 0);
   r = e->RegisterObjectBehaviour("WebSocketMessage", asBEHAVE_ADDREF, "void f()", asMETHOD(Net::WebSocketMessage, addRef), asCALL_THISCALL); assert( r >= 0 );
@@ -1317,7 +2310,9 @@ auto RegisterNet(asIScriptEngine *e) -> void {
   r = e->RegisterObjectMethod("WebSocketMessage", "uint8 get_opcode() property", asMETHOD(Net::WebSocketMessage, get_opcode), asCALL_THISCALL); assert( r >= 0 );
   r = e->RegisterObjectMethod("WebSocketMessage", "void set_opcode(uint8 value) property", asMETHOD(Net::WebSocketMessage, set_opcode), asCALL_THISCALL); assert( r >= 0 );
   r = e->RegisterObjectMethod("WebSocketMessage", "string &as_string()", asMETHOD(Net::WebSocketMessage, as_string), asCALL_THISCALL); assert( r >= 0 );
-  r = e->RegisterObjectMethod("WebSocketMessage", "array<uint8> &as_array()", asMETHOD(Net::WebSocketMessage, as_array), asCALL_THISCALL); assert( r >= 0 );
+  r = e->RegisterObjectMethod("WebSocketMessage", "array<uint8>@ as_array()", asMETHOD(Net::WebSocketMessage, as_array), asCALL_THISCALL); assert( r >= 0 );
+  r = e->RegisterObjectMethod("WebSocketMessage", "uint get_length() property", asMETHOD(Net::WebSocketMessage, get_length), asCALL_THISCALL); assert( r >= 0 );
+  r = e->RegisterObjectMethod("WebSocketMessage", "uint8 opIndex(uint index)", asMETHOD(Net::WebSocketMessage, at), asCALL_THISCALL); assert( r >= 0 );
   r = e->RegisterObjectMethod("WebSocketMessage", "void set_payload_as_string(string &in value) property", asMETHOD(Net::WebSocketMessage, set_payload_as_string), asCALL_THISCALL); assert( r >= 0 );
   r = e->RegisterObjectMethod("WebSocketMessage", "void set_payload_as_array(array<uint8> &in value) property", asMETHOD(Net::WebSocketMessage, set_payload_as_array), asCALL_THISCALL); assert( r >= 0 );
 
@@ -1342,4 +2337,32 @@ auto RegisterNet(asIScriptEngine *e) -> void {
   r = e->RegisterObjectBehaviour("WebSocketServer", asBEHAVE_RELEASE, "void f()", asMETHOD(Net::WebSocketServer, release), asCALL_THISCALL); assert( r >= 0 );
   r = e->RegisterObjectMethod("WebSocketServer", "array<WebSocket@> &get_clients() property", asMETHOD(Net::WebSocketServer, get_clients), asCALL_THISCALL); assert( r >= 0 );
   r = e->RegisterObjectMethod("WebSocketServer", "int process()", asMETHOD(Net::WebSocketServer, process), asCALL_THISCALL); assert( r >= 0 );
+
+  // Worker type; does all socket I/O on a background thread and exchanges whole messages with the script:
+  r = e->RegisterEnum("event"); assert(r >= 0);
+  r = e->RegisterEnumValue("event", "opened", Net::WorkerEvent::Opened); assert(r >= 0);
+  r = e->RegisterEnumValue("event", "received", Net::WorkerEvent::Received); assert(r >= 0);
+  r = e->RegisterEnumValue("event", "disconnected", Net::WorkerEvent::Closed); assert(r >= 0);
+
+  r = e->RegisterObjectType("Event", 0, asOBJ_REF); assert(r >= 0);
+  r = e->RegisterObjectBehaviour("Event", asBEHAVE_ADDREF, "void f()", asMETHOD(Net::WorkerEvent, addRef), asCALL_THISCALL); assert( r >= 0 );
+  r = e->RegisterObjectBehaviour("Event", asBEHAVE_RELEASE, "void f()", asMETHOD(Net::WorkerEvent, release), asCALL_THISCALL); assert( r >= 0 );
+  REG_LAMBDA(Event, "uint get_kind() property",    ([](Net::WorkerEvent& self) { return self.kind; }));
+  REG_LAMBDA(Event, "int get_channel() property",  ([](Net::WorkerEvent& self) { return (int)self.channel; }));
+  REG_LAMBDA(Event, "int get_server() property",   ([](Net::WorkerEvent& self) { return (int)self.server; }));
+  REG_LAMBDA(Event, "int get_error() property",    ([](Net::WorkerEvent& self) { return self.error; }));
+  r = e->RegisterObjectMethod("Event", "string get_error_text() property", asMETHOD(Net::WorkerEvent, get_error_text), asCALL_THISCALL); assert( r >= 0 );
+  r = e->RegisterObjectMethod("Event", "WebSocketMessage@ get_message() property", asMETHOD(Net::WorkerEvent, get_message), asCALL_THISCALL); assert( r >= 0 );
+
+  r = e->RegisterObjectType("Worker", 0, asOBJ_REF); assert(r >= 0);
+  r = e->RegisterObjectBehaviour("Worker", asBEHAVE_FACTORY, "Worker@ f()", asFUNCTION(Net::create_worker), asCALL_CDECL); assert(r >= 0);
+  r = e->RegisterObjectBehaviour("Worker", asBEHAVE_ADDREF, "void f()", asMETHOD(Net::Worker, addRef), asCALL_THISCALL); assert( r >= 0 );
+  r = e->RegisterObjectBehaviour("Worker", asBEHAVE_RELEASE, "void f()", asMETHOD(Net::Worker, release), asCALL_THISCALL); assert( r >= 0 );
+  REG_LAMBDA(Worker, "int listen_websocket(const string &in uri)", ([](Net::Worker& self, string* uri) { return self.listen_web_socket(*uri); }));
+  REG_LAMBDA(Worker, "int connect(Address@ addr)", ([](Net::Worker& self, const Net::Address* addr) { return self.connect(addr); }));
+  REG_LAMBDA(Worker, "bool send(int channel, WebSocketMessage@+ msg)",
+    ([](Net::Worker& self, int channel, Net::WebSocketMessage* msg) { return self.send(channel, msg); })
+  );
+  REG_LAMBDA(Worker, "bool close(int channel)", ([](Net::Worker& self, int channel) { return self.close(channel); }));
+  REG_LAMBDA(Worker, "Event@ poll()",           ([](Net::Worker& self) -> Net::WorkerEvent* { return self.poll(); }));
 }
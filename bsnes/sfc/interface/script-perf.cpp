@@ -0,0 +1,38 @@
+auto RegisterPerf(asIScriptEngine *e) -> void {
+  using Profiler = Scheduler::Profiler;
+  using Stats    = Profiler::Stats;
+
+  int r;
+
+  {
+    r = e->SetDefaultNamespace("perf"); assert(r >= 0);
+
+    // components are numbered in this order; `components` is their count:
+    r = e->RegisterEnum("component"); assert(r >= 0);
+    for (uint n : range(Profiler::Components)) {
+      r = e->RegisterEnumValue("component", Profiler::Names[n], n); assert(r >= 0);
+    }
+    r = e->RegisterEnumValue("component", "components", Profiler::Components); assert(r >= 0);
+
+    // profiling adds a timer read to every thread switch, so it is off until a script enables it:
+    REG_LAMBDA_GLOBAL("bool get_enabled() property", ([]() -> bool { return scheduler.profiler.enabled; }));
+    REG_LAMBDA_GLOBAL("void set_enabled(bool enabled) property", ([](bool enabled) { scheduler.profiler.setEnabled(enabled); }));
+
+    // statistics of the last completed frame; all zero until a full frame has been profiled:
+    REG_REF_NOCOUNT(stats);
+    REG_LAMBDA(stats, "uint64 get_total_nanoseconds() property", ([](Stats& self) -> uint64 { return self.nanoseconds(); }));
+    REG_LAMBDA(stats, "uint64 nanoseconds(component c) const", ([](Stats& self, uint c) -> uint64 {
+      return c < Profiler::Components ? self.time[c] : 0;
+    }));
+    REG_LAMBDA(stats, "uint64 clocks(component c) const", ([](Stats& self, uint c) -> uint64 {
+      return c < Profiler::Components ? self.clocks[c] : 0;
+    }));
+    REG_LAMBDA(stats, "uint64 switches(component from, component to) const", ([](Stats& self, uint from, uint to) -> uint64 {
+      return from < Profiler::Components && to < Profiler::Components ? self.switches[from][to] : 0;
+    }));
+    REG_LAMBDA_GLOBAL("string name(component c)", ([](uint c) -> string {
+      return c < Profiler::Components ? Profiler::Names[c] : "";
+    }));
+    REG_LAMBDA_GLOBAL("stats@ get_frame_stats() property", ([]() -> Stats* { return &scheduler.profiler.last; }));
+  }
+}
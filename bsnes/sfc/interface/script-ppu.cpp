@@ -54,6 +54,7 @@ struct PPUAccess {
   auto cgram_write(uint8 addr, uint16 value) {
     if (system.fastPPU()) {
       ppufast.cgram[addr] = value;
+      ppufast.snapshots.cgramDirty = true;
     }
     ppu.screen.cgram[addr] = value;
   }
@@ -69,9 +70,11 @@ struct PPUAccess {
     if (system.fastPPU()) {
       auto vram = (uint16 *)ppufast.vram;
       vram[addr & 0x7fff] = value;
+      ppufast.vramPages.mark((addr & 0x7fff) << 1);
     } else {
       auto vram = (uint16 *)ppu.vram.data;
       vram[addr & 0x7fff] = value;
+      ppu.vramPages.mark((addr & 0x7fff) << 1);
     }
   }
 
@@ -117,6 +120,7 @@ struct PPUAccess {
       for (uint a = 0; a < size; a++) {
         auto word = *p++;
         vram[(addr + a) & 0x7fff] = word;
+        ppufast.vramPages.mark(((addr + a) & 0x7fff) << 1);
         // TODO: update cache for ppufast?
       }
     } else {
@@ -124,6 +128,7 @@ struct PPUAccess {
       for (uint a = 0; a < size; a++) {
         auto word = *p++;
         vram[(addr + a) & 0x7fff] = word;
+        ppu.vramPages.mark(((addr + a) & 0x7fff) << 1);
       }
     }
   }
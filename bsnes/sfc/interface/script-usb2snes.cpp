@@ -0,0 +1,333 @@
+// built-in server for the usb2snes (QUsb2snes) websocket protocol, so auto-trackers, practice tools and other usb2snes
+// clients can read and write the emulated console's memory as they would an FX Pak Pro's, without a script in between.
+// its sockets and websocket framing live on a Net::Worker thread; requests are answered in one batch per frame at the
+// start of the frame, where memory is consistent and is copied directly instead of read through the bus.
+namespace Usb2snes {
+  // a request as seen by script subscribers; only valid for the duration of the callback:
+  struct Request {
+    uint client;
+    string name;
+    string opcode;
+    string space;
+    vector<string> operands;
+    vector<string> results;
+    bool handled = false;
+
+    auto operand(uint index) -> string {
+      if (index >= operands.size()) {
+        asGetActiveContext()->SetException("index out of range", true);
+        return {};
+      }
+      return operands[index];
+    }
+
+    auto reply(const string& result) -> void {
+      results.append(result);
+      handled = true;
+    }
+  };
+
+  struct Server {
+    ~Server() {
+      stop();
+    }
+
+    auto serve() -> void {
+      auto& settings = configuration.network.usb2snes;
+      if (!settings.enable) {
+        if (worker) stop();
+        host = {};
+        port = 0;
+        return;
+      }
+
+      // (re)start on a change of address; a failed address is not retried until it changes:
+      if (settings.host != host || settings.port != port) {
+        stop();
+        host = settings.host;
+        port = settings.port;
+        if (!start()) {
+          platform->scriptMessage({"usb2snes: unable to listen on ", host, ":", port}, false, ::Script::MSG_WARN);
+        }
+      }
+      if (!worker) return;
+
+      while (auto event = worker->poll()) {
+        handle(event);
+        event->release();
+      }
+    }
+
+    auto subscribe(asIScriptFunction* cb) -> void {
+      if (!cb) return;
+      subscribers.append(new ::Script::CallSite<Request*>(platform, cb));
+    }
+
+    auto unsubscribe() -> void {
+      for (auto subscriber : subscribers) delete subscriber;
+      subscribers.reset();
+    }
+
+  private:
+    struct Client {
+      struct Range {
+        uint address;
+        uint size;
+      };
+
+      uint channel;
+      string name;
+      vector<Range> puts;       // PutAddress ranges still waiting for their data
+      vector<uint8_t> pending;  // data received for them so far
+      uint expected = 0;        // total size of the ranges
+    };
+
+    Net::Worker* worker = nullptr;
+    int listener = -1;
+    string host;
+    uint port = 0;
+    vector<Client*> clients;
+    vector<::Script::CallSite<Request*>*> subscribers;
+
+    auto start() -> bool {
+      worker = Net::create_worker();
+      if (!worker) return false;
+      listener = worker->listen_web_socket(host, string{port});
+      if (listener < 0) {
+        stop();
+        return false;
+      }
+      return true;
+    }
+
+    auto stop() -> void {
+      for (auto client : clients) delete client;
+      clients.reset();
+      if (worker) worker->release();
+      worker = nullptr;
+      listener = -1;
+    }
+
+    auto find(uint channel) -> Client* {
+      for (auto client : clients) {
+        if (client->channel == channel) return client;
+      }
+      return nullptr;
+    }
+
+    auto handle(Net::WorkerEvent* event) -> void {
+      if (event->kind == Net::WorkerEvent::Opened) {
+        if ((int)event->server != listener) return;
+        auto client = new Client;
+        client->channel = event->channel;
+        clients.append(client);
+        return;
+      }
+
+      auto client = find(event->channel);
+      if (!client) return;
+
+      if (event->kind == Net::WorkerEvent::Closed) {
+        clients.removeByValue(client);
+        delete client;
+        return;
+      }
+
+      auto message = event->message;
+      if (message->opcode == 1) {
+        auto payload = message->payload();
+        request(*client, (const char*)payload.data(), (const char*)payload.data() + payload.size());
+      } else if (message->opcode == 2) {
+        receive(*client, message->payload());
+      } else if (message->opcode == 8 || message->opcode == 9) {
+        // echo a close frame before closing, and answer a ping with a pong:
+        vector<uint8_t> bytes;
+        bytes.appends(message->payload());
+        worker->send(client->channel, message->opcode == 8 ? 8 : 10, move(bytes));
+        if (message->opcode == 8) worker->close(client->channel);
+      }
+    }
+
+    auto request(Client& client, const char* first, const char* last) -> void {
+      picojson::value document;
+      std::string error;
+      picojson::parse(document, first, last, &error);
+      if (!error.empty() || !document.is<picojson::object>()) {
+        // QUsb2snes also drops clients that send malformed requests:
+        worker->close(client.channel);
+        return;
+      }
+
+      auto& object = document.get<picojson::object>();
+      auto field = [&](const char* name) -> string {
+        auto it = object.find(name);
+        if (it == object.end() || !it->second.is<std::string>()) return {};
+        return stdToNall(it->second.get<std::string>());
+      };
+
+      Request request;
+      request.client = client.channel;
+      request.name = client.name;
+      request.opcode = field("Opcode");
+      request.space = field("Space");
+      auto operands = object.find("Operands");
+      if (operands != object.end() && operands->second.is<picojson::array>()) {
+        for (auto& operand : operands->second.get<picojson::array>()) {
+          request.operands.append(operand.is<std::string>() ? stdToNall(operand.get<std::string>()) : string{});
+        }
+      }
+
+      // subscribers see every request first, and may answer it in place of the server:
+      for (auto subscriber : subscribers) (*subscriber)(&request);
+      if (request.handled) {
+        if (request.results) reply(client, request.results);
+        return;
+      }
+
+      auto& opcode = request.opcode;
+      if (opcode == "DeviceList") {
+        reply(client, {"bsnes-as"});
+      } else if (opcode == "Attach") {
+        // there is only one device, which is always attached
+      } else if (opcode == "Name") {
+        if (request.operands) client.name = request.operands[0];
+      } else if (opcode == "AppVersion") {
+        reply(client, {"1.0.0"});
+      } else if (opcode == "Info") {
+        reply(client, {"1.0.0", "bsnes-as", cartridge.headerTitle(), "NO_CONTROL_CMD", "NO_FILE_CMD"});
+      } else if (opcode == "GetAddress" && request.space == "SNES") {
+        get(client, request.operands);
+      } else if (opcode == "PutAddress" && request.space == "SNES") {
+        put(client, request.operands);
+      }
+    }
+
+    auto reply(Client& client, const vector<string>& results) -> void {
+      picojson::array array;
+      for (auto& result : results) array.push_back(picojson::value(nallToStd(result)));
+      picojson::object object;
+      object["Results"] = picojson::value(array);
+      auto text = picojson::value(object).serialize();
+
+      vector<uint8_t> bytes;
+      bytes.appends({(const uint8_t*)text.data(), (uint)text.size()});
+      worker->send(client.channel, 1, move(bytes));
+    }
+
+    // operands are pairs of hexadecimal address and size:
+    static auto ranges(const vector<string>& operands, vector<Client::Range>& output) -> uint {
+      uint total = 0;
+      for (uint i = 0; i + 1 < operands.size(); i += 2) {
+        uint address = operands[i].hex() & 0xffffff;
+        uint size = min(operands[i + 1].hex(), (uintmax)0x1000000);
+        if (total + size > 0x1000000) break;
+        output.append({address, size});
+        total += size;
+      }
+      return total;
+    }
+
+    // every range is answered in a single binary message:
+    auto get(Client& client, const vector<string>& operands) -> void {
+      vector<Client::Range> reads;
+      uint total = ranges(operands, reads);
+      if (!total) return;
+
+      vector<uint8_t> bytes;
+      bytes.resize(total);  // zero-filled, which is what unmapped addresses read as
+      uint offset = 0;
+      for (auto& range : reads) {
+        copy(range.address, range.size, [&](uint8_t* memory, uint at, uint length, bool) {
+          memory::copy(bytes.data() + offset + at, memory, length);
+        });
+        offset += range.size;
+      }
+      worker->send(client.channel, 2, move(bytes));
+    }
+
+    // the data follows in one or more binary messages:
+    auto put(Client& client, const vector<string>& operands) -> void {
+      client.puts.reset();
+      client.pending.reset();
+      client.expected = ranges(operands, client.puts);
+    }
+
+    auto receive(Client& client, array_view<uint8_t> payload) -> void {
+      if (!client.expected) return;
+
+      client.pending.appends({payload.data(), min(payload.size(), client.expected - client.pending.size())});
+      if (client.pending.size() < client.expected) return;
+
+      uint offset = 0;
+      for (auto& range : client.puts) {
+        copy(range.address, range.size, [&](uint8_t* memory, uint at, uint length, bool wram) {
+          memory::copy(memory, client.pending.data() + offset + at, length);
+          if (!wram) return;
+          // keep incremental save states in step with memory written behind the CPU's back:
+          uint first = memory - cpu.wram;
+          for (uint page = first & ~(DirtyPages::PageSize - 1); page < first + length; page += DirtyPages::PageSize) {
+            cpu.wramPages.mark(page);
+          }
+        });
+        offset += range.size;
+      }
+      client.puts.reset();
+      client.pending.reset();
+      client.expected = 0;
+    }
+
+    // walks [address, address + size) in the FX Pak Pro's address space, calling `visit(memory, at, length, wram)`
+    // for each mapped piece, where `at` is the piece's offset into the range. unmapped addresses are skipped:
+    //   $000000-$dfffff ROM, $e00000-$efffff SRAM, $f50000-$f6ffff WRAM
+    template<typename F> static auto copy(uint address, uint size, const F& visit) -> void {
+      uint at = 0;
+      while (at < size && address + at < 0x1000000) {
+        uint current = address + at;
+        uint base, limit, capacity = 0;
+        uint8_t* memory = nullptr;
+        bool wram = false;
+        if (current < 0xe00000) {
+          base = 0x000000, limit = 0xe00000, memory = cartridge.rom.data(), capacity = cartridge.rom.size();
+        } else if (current < 0xf00000) {
+          base = 0xe00000, limit = 0xf00000, memory = cartridge.ram.data(), capacity = cartridge.ram.size();
+        } else if (current < 0xf50000) {
+          base = 0xf00000, limit = 0xf50000;
+        } else if (current < 0xf70000) {
+          base = 0xf50000, limit = 0xf70000, memory = cpu.wram, capacity = sizeof(cpu.wram), wram = true;
+        } else {
+          base = 0xf70000, limit = 0x1000000;
+        }
+
+        uint length = min(size - at, limit - current);
+        uint offset = current - base;
+        if (memory && offset < capacity) visit(memory + offset, at, min(length, capacity - offset), wram);
+        at += length;
+      }
+    }
+  };
+
+  Server server;
+}
+
+auto RegisterUsb2snes(asIScriptEngine *e) -> void {
+  int r;
+
+  r = e->SetDefaultNamespace("usb2snes"); assert(r >= 0);
+
+  // requests made to the built-in server, enabled by the Network/Usb2snes/Enable option:
+  r = e->RegisterObjectType("Request", sizeof(Usb2snes::Request), asOBJ_REF | asOBJ_NOCOUNT); assert(r >= 0);
+  REG_LAMBDA(Request, "uint get_client() property", ([](Usb2snes::Request& self) -> uint { return self.client; }));
+  REG_LAMBDA(Request, "string get_name() property", ([](Usb2snes::Request& self) -> string { return self.name; }));
+  REG_LAMBDA(Request, "string get_opcode() property", ([](Usb2snes::Request& self) -> string { return self.opcode; }));
+  REG_LAMBDA(Request, "string get_space() property", ([](Usb2snes::Request& self) -> string { return self.space; }));
+  REG_LAMBDA(Request, "uint get_operand_count() property", ([](Usb2snes::Request& self) -> uint { return self.operands.size(); }));
+  REG_LAMBDA(Request, "string get_operands(uint index) property", ([](Usb2snes::Request& self, uint index) -> string { return self.operand(index); }));
+  // answer the request with a result string; each call adds one result, and the server will not answer it:
+  REG_LAMBDA(Request, "void reply(const string &in result)", ([](Usb2snes::Request& self, const string& result) { self.reply(result); }));
+  // set to stop the server from answering the request without replying to it:
+  r = e->RegisterObjectProperty("Request", "bool handled", asOFFSET(Usb2snes::Request, handled)); assert(r >= 0);
+
+  // subscribers are called for every request, in order, before the server answers it:
+  r = e->RegisterFuncdef("void RequestCallback(Request @request)"); assert(r >= 0);
+  REG_LAMBDA_GLOBAL("void subscribe(RequestCallback @cb)", ([](asIScriptFunction* cb) { Usb2snes::server.subscribe(cb); }));
+}
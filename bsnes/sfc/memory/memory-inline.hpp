@@ -31,8 +31,13 @@ auto Bus::write(uint addr, uint8 data) -> void {
   uint8 fn = lookup[addr];
   uint32 offset = target[addr];
 
-  // call interceptor before actual write takes place:
-  interceptor[interceptor_lookup[addr]](addr, data, [=](){ return reader[fn](offset, 0); });
+  // call interceptor before actual write takes place; uncovered addresses skip it entirely so the
+  // old value is only read (and its closure only built) when an interceptor actually wants it:
+  if(interceptors) {
+    if(uint8 id = interceptor_lookup[addr]) {
+      interceptor[id](addr, data, [=](){ return reader[fn](offset, 0); });
+    }
+  }
 
   return writer[fn](offset, data);
 }
@@ -3,6 +3,8 @@
 namespace SuperFamicom {
 
 bool Memory::GlobalWriteEnable = false;
+uint32 DirtyPages::generation = 1;
+uint32 DirtyPages::base = 0;
 Bus bus;
 
 Bus::~Bus() {
@@ -36,6 +38,7 @@ auto Bus::reset_interceptors() -> void {
     interceptor[id].reset();
     interceptor_counter[id] = 0;
   }
+  interceptors = 0;
 
   if(interceptor_lookup) delete[] interceptor_lookup;
 
@@ -148,10 +151,11 @@ auto Bus::add_write_interceptor(
           uint pid = interceptor_lookup[bank << 16u | addr];
           if(pid && --interceptor_counter[pid] == 0) {
             interceptor[pid].reset();
+            interceptors--;
           }
 
           interceptor_lookup[bank << 16u | addr] = id;
-          interceptor_counter[id]++;
+          if(interceptor_counter[id]++ == 0) interceptors++;
         }
       }
     }
@@ -160,4 +164,33 @@ auto Bus::add_write_interceptor(
   return id;
 }
 
+auto DirtyPages::serialize(serializer& s, uint8* data, uint size) -> void {
+  if(s.mode() == serializer::Size || !base) {
+    s.array(data, size);
+    if(s.mode() == serializer::Load) markAll();
+    return;
+  }
+
+  for(uint offset = 0; offset < size; offset += PageSize) {
+    uint length = min((uint)PageSize, size - offset);
+    auto& page = pages[offset >> PageBits];
+    if(page > base) {
+      s.array(data + offset, length);
+      //a restored page no longer matches any state captured after the base state:
+      if(s.mode() == serializer::Load) page = generation;
+    } else {
+      s.skip(length);
+    }
+  }
+}
+
+auto DirtyPages::serialize(serializer& s, uint16* data, uint size) -> void {
+  #if defined(ENDIAN_LSB)
+  serialize(s, (uint8*)data, size * sizeof(uint16));
+  #else
+  s.array(data, size);
+  if(s.mode() == serializer::Load) markAll();
+  #endif
+}
+
 }
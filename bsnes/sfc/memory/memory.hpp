@@ -20,6 +20,24 @@ struct Memory {
 #include "writable.hpp"
 #include "protectable.hpp"
 
+//dirty page tracking for incremental serialization:
+//each page of a large memory region records the generation in which it was last written,
+//so that System::serialize(serializer&, uint&) only needs to copy pages newer than its base state,
+//and System::unserialize(serializer&, uint) only needs to restore those same pages.
+struct DirtyPages {
+  enum : uint { PageBits = 10, PageSize = 1 << PageBits, Pages = 128 * 1024 >> PageBits };
+  static uint32 generation;  //incremented after every incremental serialization
+  static uint32 base;        //generation of the state being updated or restored; 0 = copy every page
+
+  alwaysinline auto mark(uint address) -> void { pages[address >> PageBits & Pages - 1] = generation; }
+  auto markAll() -> void { for(auto& page : pages) page = generation; }
+  auto serialize(serializer& s, uint8* data, uint size) -> void;
+  auto serialize(serializer& s, uint16* data, uint size) -> void;
+
+private:
+  uint32 pages[Pages] = {};
+};
+
 struct Bus {
   using interceptor_fn = function<void (uint, uint8, uint8)>;
 
@@ -63,6 +81,7 @@ private:
   uint8* interceptor_lookup = nullptr;
   function<void (uint, uint8, const function<uint8()> &)> interceptor[256];
   uint interceptor_counter[256];
+  uint interceptors = 0;  //number of interceptor ids currently covering at least one address
 };
 
 extern Bus bus;
@@ -1,12 +1,12 @@
 
-auto PPU::Line::renderBackground(PPU::IO::Background& self, uint8 source) -> void {
+auto PPU::Line::renderBackground(const PPU::IO::Background& self, uint8 source) -> void {
   if (!self.aboveEnable && !self.belowEnable) return;
 
   auto tMode = self.tileMode;
   if (tMode == TileMode::Mode7) {
     return renderMode7(self, source);
   } else if (tMode == TileMode::BPP2) {
-    switch (io.bgMode) {
+    switch (io->bgMode) {
       case 0: _renderBackgroundTileMode<0, TileMode::BPP2>(self, source); break;
       case 1: _renderBackgroundTileMode<1, TileMode::BPP2>(self, source); break;
       case 2: _renderBackgroundTileMode<2, TileMode::BPP2>(self, source); break;
@@ -16,7 +16,7 @@ auto PPU::Line::renderBackground(PPU::IO::Background& self, uint8 source) -> voi
       case 6: _renderBackgroundTileMode<6, TileMode::BPP2>(self, source); break;
     }
   } else if (tMode == TileMode::BPP4) {
-    switch (io.bgMode) {
+    switch (io->bgMode) {
       case 0: _renderBackgroundTileMode<0, TileMode::BPP4>(self, source); break;
       case 1: _renderBackgroundTileMode<1, TileMode::BPP4>(self, source); break;
       case 2: _renderBackgroundTileMode<2, TileMode::BPP4>(self, source); break;
@@ -26,7 +26,7 @@ auto PPU::Line::renderBackground(PPU::IO::Background& self, uint8 source) -> voi
       case 6: _renderBackgroundTileMode<6, TileMode::BPP4>(self, source); break;
     }
   } else if (tMode == TileMode::BPP8) {
-    switch (io.bgMode) {
+    switch (io->bgMode) {
       case 0: _renderBackgroundTileMode<0, TileMode::BPP8>(self, source); break;
       case 1: _renderBackgroundTileMode<1, TileMode::BPP8>(self, source); break;
       case 2: _renderBackgroundTileMode<2, TileMode::BPP8>(self, source); break;
@@ -41,10 +41,10 @@ auto PPU::Line::renderBackground(PPU::IO::Background& self, uint8 source) -> voi
 }
 
 template<uint8 bgMode, uint8 tMode>
-auto PPU::Line::_renderBackgroundTileMode(PPU::IO::Background& self, uint8 source) -> void {
+auto PPU::Line::_renderBackgroundTileMode(const PPU::IO::Background& self, uint8 source) -> void {
   constexpr bool hires = bgMode == 5 || bgMode == 6;
   constexpr bool offsetPerTileMode = bgMode == 2 || bgMode == 4 || bgMode == 6;
-  bool directColorMode = io.col.directColor && source == Source::BG1 && (bgMode == 3 || bgMode == 4);
+  bool directColorMode = io->col.directColor && source == Source::BG1 && (bgMode == 3 || bgMode == 4);
   constexpr uint colorShift = 3 + tMode;
   constexpr int width = 256 << hires;
 
@@ -76,22 +76,22 @@ auto PPU::Line::_renderBackgroundTileMode(PPU::IO::Background& self, uint8 sourc
   uint vmask = (width << self.tileSize << !!(self.screenSize & 2)) - 1;
 
   uint y = this->y;
-  if(self.mosaicEnable) y -= io.mosaic.size - io.mosaic.counter;
+  if(self.mosaicEnable) y -= io->mosaic.size - io->mosaic.counter;
   if constexpr(hires) {
     hscroll <<= 1;
-    if(io.interlace) {
+    if(io->interlace) {
       y = y << 1 | field();
-      if(self.mosaicEnable) y -= io.mosaic.size - io.mosaic.counter + field();
+      if(self.mosaicEnable) y -= io->mosaic.size - io->mosaic.counter + field();
     }
   }
 
-  uint mosaicCounterTop = self.mosaicEnable ? io.mosaic.size : 1;
+  uint mosaicCounterTop = self.mosaicEnable ? io->mosaic.size : 1;
   uint mosaicCounter = 1;
   uint mosaicPalette = 0;
   uint8 mosaicPriority = 0;
   uint16 mosaicColor = 0;
 
-  auto getTile = [=](PPU::IO::Background& self, uint hoffset, uint voffset) -> uint {
+  auto getTile = [=](const PPU::IO::Background& self, uint hoffset, uint voffset) -> uint {
     //uint screenX = self.screenSize & 1 ? 32 << 5 : 0;
     //uint screenY = self.screenSize & 2 ? 32 << 5 + (self.screenSize & 1) : 0;
     uint screenX = (self.screenSize & 1) << 10;
@@ -114,7 +114,7 @@ auto PPU::Line::_renderBackgroundTileMode(PPU::IO::Background& self, uint8 sourc
       uint validBit = 0x2000 << source;
       uint offsetX = x + (hscroll & 7);
       if(offsetX >= 8) {  //first column is exempt
-        uint hlookup = getTile(io.bg3, (offsetX - 8) + (io.bg3.hoffset & ~7), io.bg3.voffset + 0);
+        uint hlookup = getTile(io->bg3, (offsetX - 8) + (io->bg3.hoffset & ~7), io->bg3.voffset + 0);
         if constexpr(bgMode == 4) {
           if(hlookup & validBit) {
             if(!(hlookup & 0x8000)) {
@@ -124,7 +124,7 @@ auto PPU::Line::_renderBackgroundTileMode(PPU::IO::Background& self, uint8 sourc
             }
           }
         } else {
-          uint vlookup = getTile(io.bg3, (offsetX - 8) + (io.bg3.hoffset & ~7), io.bg3.voffset + 8);
+          uint vlookup = getTile(io->bg3, (offsetX - 8) + (io->bg3.hoffset & ~7), io->bg3.voffset + 8);
           if(hlookup & validBit) {
             hoffset = offsetX + (hlookup & ~7);
           }
@@ -1,10 +1,12 @@
 auto PPU::latchCounters(uint hcounter, uint vcounter) -> void {
+  snapshots.ioDirty = true;
   io.hcounter = hcounter;
   io.vcounter = vcounter;
   latch.counters = 1;
 }
 
 auto PPU::latchCounters() -> void {
+  snapshots.ioDirty = true;
   io.hcounter = cpu.hdot();
   io.vcounter = cpu.vcounter();
   latch.counters = 1;
@@ -38,6 +40,7 @@ auto PPU::writeVRAM(uint8 data) -> void {
   if constexpr(Byte == 1) {
     vram[address] = vram[address] & 0x00ff | data << 8;
   }
+  vramPages.mark(address << 1);
 }
 
 auto PPU::readOAM(uint10 address) -> uint8 {
@@ -72,10 +75,12 @@ auto PPU::writeCGRAM(uint8 address, uint15 data) -> void {
   && cpu.hcounter() >= 88 && cpu.hcounter() < 1096
   ) address = latch.cgramAddress;
   cgram[address] = data;
+  snapshots.cgramDirty = true;
 }
 
 auto PPU::readIO(uint address, uint8 data) -> uint8 {
   cpu.synchronizePPU();
+  snapshots.ioDirty = true;
 
   switch(address & 0xffff) {
 
@@ -191,6 +196,7 @@ auto PPU::readIO(uint address, uint8 data) -> uint8 {
 
 auto PPU::writeIO(uint address, uint8 data) -> void {
   cpu.synchronizePPU();
+  snapshots.ioDirty = true;
 
   switch(address & 0xffff) {
 
@@ -0,0 +1,87 @@
+PPU::LineQueue::~LineQueue() {
+  stop();
+}
+
+auto PPU::LineQueue::resize(uint threads) -> void {
+  if(threads == workers.size()) return;
+
+  wait();
+  stop();
+  for(uint n : range(threads)) {
+    workers.emplace_back([this] { worker(); });
+  }
+}
+
+auto PPU::LineQueue::push(uint y, Mode mode) -> void {
+  if(workers.empty()) {
+    auto& line = ppu.lines[y];
+    if(mode != Mode::Odd) line.render(0);
+    if(mode != Mode::Even) line.render(1);
+    return;
+  }
+
+  //the queue is drained every frame, so this only happens if a flush was missed:
+  if(tail.load() - done.load() >= Size) wait();
+
+  uint index = tail.load();
+  jobs[index & Mask] = y | (uint)mode << 8;
+  tail.store(index + 1);
+
+  if(sleeping.load()) {
+    std::lock_guard<std::mutex> guard(lock);
+    wake.notify_one();
+  }
+}
+
+auto PPU::LineQueue::wait() -> void {
+  //render whatever is still queued on this thread, then wait for the workers to finish:
+  while(run());
+  while(done.load() != tail.load()) std::this_thread::yield();
+}
+
+//claim and render one queued line; returns false if the queue was empty:
+auto PPU::LineQueue::run() -> bool {
+  uint index = head.load();
+  while(index != tail.load()) {
+    if(!head.compare_exchange_weak(index, index + 1)) continue;
+
+    uint job = jobs[index & Mask];
+    auto& line = ppu.lines[job & 255];
+    auto mode = (Mode)(job >> 8);
+    if(mode != Mode::Odd) line.render(0);
+    if(mode != Mode::Even) line.render(1);
+
+    done.fetch_add(1);
+    return true;
+  }
+  return false;
+}
+
+auto PPU::LineQueue::worker() -> void {
+  while(true) {
+    if(run()) continue;
+
+    //spin briefly, since the next line is usually queued within a scanline's worth of time:
+    for(uint spin = 0; spin < Spins && !pending() && !quit.load(); spin++) {
+      std::this_thread::yield();
+    }
+    if(pending()) continue;
+    if(quit.load()) return;
+
+    std::unique_lock<std::mutex> guard(lock);
+    sleeping.fetch_add(1);
+    wake.wait(guard, [this] { return pending() || quit.load(); });
+    sleeping.fetch_sub(1);
+  }
+}
+
+auto PPU::LineQueue::stop() -> void {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    quit.store(true);
+    wake.notify_all();
+  }
+  for(auto& thread : workers) thread.join();
+  workers.clear();
+  quit.store(false);
+}
@@ -1,111 +1,52 @@
 uint PPU::Line::start = 0;
 uint PPU::Line::count = 0;
 
-auto PPU::Line::flush() -> void {
-#if 1
-  ppu.threadPool.wait();
-#else
-  if(Line::count) {
-    if(ppu.hdScale() > 1) cacheMode7HD();
-
-    auto fieldNumber = ppu.field();
-    std::function<void(PPU::Line&)> renderLine;
-    if (ppu.deinterlace()) {
-      if (!ppu.interlace()) {
-        //some games enable interlacing in 240p mode, just force these to even fields
-        renderLine = [](PPU::Line &line){
-          line.render(0);
-        };
-      } else {
-        //for actual interlaced frames, render both fields every farme for 480i -> 480p
-        renderLine = [](PPU::Line &line){
-          line.render(0);
-          line.render(1);
-        };
-      }
-    } else {
-      //standard 240p (progressive) and 480i (interlaced) rendering
-      renderLine = [fieldNumber](PPU::Line &line) {
-        line.render(fieldNumber);
-      };
-    }
-
-    if (Line::count < 8) {
-      for (uint y = 0; y < Line::count; y++) {
-        renderLine(ppu.lines[Line::start + y]);
-      }
-    } else {
-      //printf("%d\n", Line::count);
-
-      //#pragma omp parallel for if(Line::count >= 8)
-      for (uint y = 0; y < Line::count; y++) {
-        ppu.threadPool.enqueue(renderLine, std::ref(ppu.lines[Line::start + y]));
-#if 0
-        if (ppu.deinterlace()) {
-          if (!ppu.interlace()) {
-            //some games enable interlacing in 240p mode, just force these to even fields
-            ppu.lines[Line::start + y].render(0);
-          } else {
-            //for actual interlaced frames, render both fields every farme for 480i -> 480p
-            ppu.lines[Line::start + y].render(0);
-            ppu.lines[Line::start + y].render(1);
-          }
-        } else {
-          //standard 240p (progressive) and 480i (interlaced) rendering
-          ppu.lines[Line::start + y].render(ppu.field());
-        }
-#endif
-      }
-
-      ppu.threadPool.wait();
-    }
+auto PPU::Snapshots::reset() -> void {
+  ioCount = 0;
+  cgramCount = 0;
+  ioDirty = true;
+  cgramDirty = true;
+  disabled.displayDisable = true;
+}
 
-    Line::start = 0;
-    Line::count = 0;
-  }
-#endif
+auto PPU::Line::flush() -> void {
+  ppu.lineQueue.wait();
 }
 
 auto PPU::Line::cache() -> void {
+  auto& snapshots = ppu.snapshots;
   uint y = ppu.vcounter();
   if(ppu.io.displayDisable || y >= ppu.vdisp()) {
-    io.displayDisable = true;
+    io = &snapshots.disabled;
   } else {
-    memcpy(&io, &ppu.io, sizeof(io));
-    memcpy(&cgram, &ppu.cgram, sizeof(cgram));
+    //snapshots are recycled once per frame, so this can only happen if that was skipped:
+    if(snapshots.ioCount == 240 || snapshots.cgramCount == 240) flush(), snapshots.reset();
+    if(snapshots.ioDirty) {
+      memcpy(&snapshots.io[snapshots.ioCount++], &ppu.io, sizeof(IO));
+      snapshots.ioDirty = false;
+    }
+    if(snapshots.cgramDirty) {
+      memcpy(&snapshots.cgram[snapshots.cgramCount++], &ppu.cgram, sizeof(ppu.cgram));
+      snapshots.cgramDirty = false;
+    }
+    io = &snapshots.io[snapshots.ioCount - 1];
+    cgram = snapshots.cgram[snapshots.cgramCount - 1];
   }
 
-#if 1
   //if(ppu.hdScale() > 1) cacheMode7HD();
 
-  auto fieldNumber = ppu.field();
-  std::function<void(PPU::Line&)> renderLine;
-  if (ppu.deinterlace()) {
-    if (!ppu.interlace()) {
-      //some games enable interlacing in 240p mode, just force these to even fields
-      renderLine = [](PPU::Line &line){
-        line.render(0);
-      };
-    } else {
-      //for actual interlaced frames, render both fields every farme for 480i -> 480p
-      renderLine = [](PPU::Line &line){
-        line.render(0);
-        line.render(1);
-      };
-    }
+  LineQueue::Mode mode;
+  if(ppu.deinterlace()) {
+    //some games enable interlacing in 240p mode, just force these to even fields;
+    //for actual interlaced frames, render both fields every frame for 480i -> 480p
+    mode = !ppu.interlace() ? LineQueue::Mode::Even : LineQueue::Mode::Both;
   } else {
     //standard 240p (progressive) and 480i (interlaced) rendering
-    renderLine = [fieldNumber](PPU::Line &line) {
-      line.render(fieldNumber);
-    };
+    mode = !ppu.field() ? LineQueue::Mode::Even : LineQueue::Mode::Odd;
   }
 
-  // queue a task to render this line:
-  ppu.threadPool.enqueue(renderLine, std::ref(ppu.lines[y]));
-#else
-  if(!Line::count) Line::start = y;
-  Line::count++;
-#endif
+  //queue a job to render this line:
+  ppu.lineQueue.push(y, mode);
 }
 
 auto PPU::Line::render(bool fieldID) -> void {
@@ -123,14 +64,14 @@ auto PPU::Line::render(bool fieldID) -> void {
   ? (!ppu.hires() ? 256 : 512)
   : (256 * scale * scale));
 
-  if(io.displayDisable) {
+  if(io->displayDisable) {
     memory::fill<uint16>(output, width);
     return;
   }
 
-  bool hires = io.pseudoHires || io.bgMode == 5 || io.bgMode == 6;
+  bool hires = io->pseudoHires || io->bgMode == 5 || io->bgMode == 6;
   uint16 aboveColor = cgram[0];
-  uint16 belowColor = hires ? cgram[0] : io.col.fixedColor;
+  uint16 belowColor = hires ? cgram[0] : io->col.fixedColor;
   uint xa =  (hd || ss) && ppu.interlace() && field() ? 256 * scale * scale / 2 : 0;
   uint xb = !(hd || ss) ? 256 : ppu.interlace() && !field() ? 256 * scale * scale / 2 : 256 * scale * scale;
   for(uint x = xa; x < xb; x++) {
@@ -142,16 +83,16 @@ auto PPU::Line::render(bool fieldID) -> void {
   //but for HD mode 7, a larger grid of pixels are generated, and so ordering ends up mattering.
   //as a hack for Mohawk & Headphone Jack, we reorder things for BG2 to render properly.
   //longer-term, we need to devise a better solution that can work for every game.
-  renderBackground(io.bg1, Source::BG1);
-  if(io.extbg == 0) renderBackground(io.bg2, Source::BG2);
-  renderBackground(io.bg3, Source::BG3);
-  renderBackground(io.bg4, Source::BG4);
-  renderObject(io.obj);
-  if(io.extbg == 1) renderBackground(io.bg2, Source::BG2);
-  renderWindow(io.col.window, io.col.window.aboveMask, windowAbove);
-  renderWindow(io.col.window, io.col.window.belowMask, windowBelow);
-
-  auto luma = ppu.lightTable[io.displayBrightness];
+  renderBackground(io->bg1, Source::BG1);
+  if(io->extbg == 0) renderBackground(io->bg2, Source::BG2);
+  renderBackground(io->bg3, Source::BG3);
+  renderBackground(io->bg4, Source::BG4);
+  renderObject(io->obj);
+  if(io->extbg == 1) renderBackground(io->bg2, Source::BG2);
+  renderWindow(io->col.window, io->col.window.aboveMask, windowAbove);
+  renderWindow(io->col.window, io->col.window.belowMask, windowBelow);
+
+  auto luma = ppu.lightTable[io->displayBrightness];
   uint curr = 0, prev = 0;
   if(hd) for(uint x : range(256 * scale * scale)) {
     *output++ = luma[pixel(x / scale & 255, above[x], below[x])];
@@ -177,13 +118,13 @@ auto PPU::Line::render(bool fieldID) -> void {
 auto PPU::Line::pixel(uint x, Pixel above, Pixel below) const -> uint16 {
   if(!windowAbove[x]) above.color = 0x0000;
   if(!windowBelow[x]) return above.color;
-  if(!io.col.enable[above.source]) return above.color;
-  if(!io.col.blendMode) return blend(above.color, io.col.fixedColor, io.col.halve && windowAbove[x]);
-  return blend(above.color, below.color, io.col.halve && windowAbove[x] && below.source != Source::COL);
+  if(!io->col.enable[above.source]) return above.color;
+  if(!io->col.blendMode) return blend(above.color, io->col.fixedColor, io->col.halve && windowAbove[x]);
+  return blend(above.color, below.color, io->col.halve && windowAbove[x] && below.source != Source::COL);
 }
 
 auto PPU::Line::blend(uint x, uint y, bool halve) const -> uint16 {
-  if(!io.col.mathMode) {  //add
+  if(!io->col.mathMode) {  //add
     if(!halve) {
       uint sum = x + y;
       uint carry = (sum - ((x ^ y) & 0x0421)) & 0x8420;
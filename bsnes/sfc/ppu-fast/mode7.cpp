@@ -1,21 +1,21 @@
-auto PPU::Line::renderMode7(PPU::IO::Background& self, uint8 source) -> void {
+auto PPU::Line::renderMode7(const PPU::IO::Background& self, uint8 source) -> void {
   //HD mode 7 support
-  if(!ppu.hdMosaic() || !self.mosaicEnable || io.mosaic.size == 1) {
+  if(!ppu.hdMosaic() || !self.mosaicEnable || io->mosaic.size == 1) {
     if(ppu.hdScale() > 1) return renderMode7HD(self, source);
   }
 
   int Y = this->y;
-  if(self.mosaicEnable) Y -= io.mosaic.size - io.mosaic.counter;
-  int y = !io.mode7.vflip ? Y : 255 - Y;
+  if(self.mosaicEnable) Y -= io->mosaic.size - io->mosaic.counter;
+  int y = !io->mode7.vflip ? Y : 255 - Y;
 
-  int a = (int16)io.mode7.a;
-  int b = (int16)io.mode7.b;
-  int c = (int16)io.mode7.c;
-  int d = (int16)io.mode7.d;
-  int hcenter = (int13)io.mode7.x;
-  int vcenter = (int13)io.mode7.y;
-  int hoffset = (int13)io.mode7.hoffset;
-  int voffset = (int13)io.mode7.voffset;
+  int a = (int16)io->mode7.a;
+  int b = (int16)io->mode7.b;
+  int c = (int16)io->mode7.c;
+  int d = (int16)io->mode7.d;
+  int hcenter = (int13)io->mode7.x;
+  int vcenter = (int13)io->mode7.y;
+  int hoffset = (int13)io->mode7.hoffset;
+  int voffset = (int13)io->mode7.voffset;
 
   uint mosaicCounter = 1;
   uint mosaicPalette = 0;
@@ -32,7 +32,7 @@ auto PPU::Line::renderMode7(PPU::IO::Background& self, uint8 source) -> void {
   renderWindow(self.window, self.window.belowEnable, windowBelow);
 
   for(int X : range(256)) {
-    int x = !io.mode7.hflip ? X : 255 - X;
+    int x = !io->mode7.hflip ? X : 255 - X;
     int pixelX = originX + a * x >> 8;
     int pixelY = originY + c * x >> 8;
     int tileX = pixelX >> 3 & 127;
@@ -40,8 +40,8 @@ auto PPU::Line::renderMode7(PPU::IO::Background& self, uint8 source) -> void {
     bool outOfBounds = (pixelX | pixelY) & ~1023;
     uint15 tileAddress = tileY * 128 + tileX;
     uint15 paletteAddress = ((pixelY & 7) << 3) + (pixelX & 7);
-    uint8 tile = io.mode7.repeat == 3 && outOfBounds ? 0 : ppu.vram[tileAddress] >> 0;
-    uint8 palette = io.mode7.repeat == 2 && outOfBounds ? 0 : ppu.vram[tile << 6 | paletteAddress] >> 8;
+    uint8 tile = io->mode7.repeat == 3 && outOfBounds ? 0 : ppu.vram[tileAddress] >> 0;
+    uint8 palette = io->mode7.repeat == 2 && outOfBounds ? 0 : ppu.vram[tile << 6 | paletteAddress] >> 8;
 
     uint8 priority;
     if(source == Source::BG1) {
@@ -52,10 +52,10 @@ auto PPU::Line::renderMode7(PPU::IO::Background& self, uint8 source) -> void {
     }
 
     if(--mosaicCounter == 0) {
-      mosaicCounter = self.mosaicEnable ? io.mosaic.size : 1;
+      mosaicCounter = self.mosaicEnable ? io->mosaic.size : 1;
       mosaicPalette = palette;
       mosaicPriority = priority;
-      if(io.col.directColor && source == Source::BG1) {
+      if(io->col.directColor && source == Source::BG1) {
         mosaicColor = directColor(0, palette);
       } else {
         mosaicColor = cgram[palette];
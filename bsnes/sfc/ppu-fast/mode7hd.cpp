@@ -2,8 +2,8 @@
 auto PPU::Line::cacheMode7HD() -> void {
   ppu.mode7LineGroups.count = 0;
   if(ppu.hdPerspective()) {
-    #define isLineMode7(line) (line.io.bg1.tileMode == TileMode::Mode7 && !line.io.displayDisable && ( \
-      (line.io.bg1.aboveEnable || line.io.bg1.belowEnable) \
+    #define isLineMode7(line) (line.io->bg1.tileMode == TileMode::Mode7 && !line.io->displayDisable && ( \
+      (line.io->bg1.aboveEnable || line.io->bg1.belowEnable) \
     ))
     bool state = false;
     uint y;
@@ -40,10 +40,10 @@ auto PPU::Line::cacheMode7HD() -> void {
       bool aVar = false, bVar = false, cVar = false, dVar = false;  //has a varying value been found for the factors?
       bool aInc = false, bInc = false, cInc = false, dInc = false;  //has the variation been an increase or decrease?
       for(y = ppu.mode7LineGroups.startLerpLine[i]; y <= ppu.mode7LineGroups.endLerpLine[i]; y++) {
-        a = ((int)((int16)(ppu.lines[y].io.mode7.a)));
-        b = ((int)((int16)(ppu.lines[y].io.mode7.b)));
-        c = ((int)((int16)(ppu.lines[y].io.mode7.c)));
-        d = ((int)((int16)(ppu.lines[y].io.mode7.d)));
+        a = ((int)((int16)(ppu.lines[y].io->mode7.a)));
+        b = ((int)((int16)(ppu.lines[y].io->mode7.b)));
+        c = ((int)((int16)(ppu.lines[y].io->mode7.c)));
+        d = ((int)((int16)(ppu.lines[y].io->mode7.d)));
         //has the value of 'a' changed compared to the last line?
         //(and is the factor larger than zero, which happens sometimes and seems to be game-specific, mostly at the edges of the screen)
         if(aPrev > 0 && a > 0 && a != aPrev) {
@@ -95,7 +95,7 @@ auto PPU::Line::cacheMode7HD() -> void {
   }
 }
 
-auto PPU::Line::renderMode7HD(PPU::IO::Background& self, uint8 source) -> void {
+auto PPU::Line::renderMode7HD(const PPU::IO::Background& self, uint8 source) -> void {
   const bool extbg = source == Source::BG2;
   const uint scale = ppu.hdScale();
 
@@ -106,8 +106,8 @@ auto PPU::Line::renderMode7HD(PPU::IO::Background& self, uint8 source) -> void {
   //find the first and last scanline for interpolation
   int y_a = -1;
   int y_b = -1;
-  #define isLineMode7(n) (ppu.lines[n].io.bg1.tileMode == TileMode::Mode7 && !ppu.lines[n].io.displayDisable && ( \
-    (ppu.lines[n].io.bg1.aboveEnable || ppu.lines[n].io.bg1.belowEnable) \
+  #define isLineMode7(n) (ppu.lines[n].io->bg1.tileMode == TileMode::Mode7 && !ppu.lines[n].io->displayDisable && ( \
+    (ppu.lines[n].io->bg1.aboveEnable || ppu.lines[n].io->bg1.belowEnable) \
   ))
   if(ppu.hdPerspective()) {
     //find the mode 7 line group this line is in and use its interpolation lines
@@ -128,24 +128,24 @@ auto PPU::Line::renderMode7HD(PPU::IO::Background& self, uint8 source) -> void {
   }
   #undef isLineMode7
 
-  Line line_a = ppu.lines[y_a];
-  float a_a = (int16)line_a.io.mode7.a;
-  float b_a = (int16)line_a.io.mode7.b;
-  float c_a = (int16)line_a.io.mode7.c;
-  float d_a = (int16)line_a.io.mode7.d;
+  auto& line_a = ppu.lines[y_a];
+  float a_a = (int16)line_a.io->mode7.a;
+  float b_a = (int16)line_a.io->mode7.b;
+  float c_a = (int16)line_a.io->mode7.c;
+  float d_a = (int16)line_a.io->mode7.d;
 
-  Line line_b = ppu.lines[y_b];
-  float a_b = (int16)line_b.io.mode7.a;
-  float b_b = (int16)line_b.io.mode7.b;
-  float c_b = (int16)line_b.io.mode7.c;
-  float d_b = (int16)line_b.io.mode7.d;
+  auto& line_b = ppu.lines[y_b];
+  float a_b = (int16)line_b.io->mode7.a;
+  float b_b = (int16)line_b.io->mode7.b;
+  float c_b = (int16)line_b.io->mode7.c;
+  float d_b = (int16)line_b.io->mode7.d;
 
-  int hcenter = (int13)io.mode7.x;
-  int vcenter = (int13)io.mode7.y;
-  int hoffset = (int13)io.mode7.hoffset;
-  int voffset = (int13)io.mode7.voffset;
+  int hcenter = (int13)io->mode7.x;
+  int vcenter = (int13)io->mode7.y;
+  int hoffset = (int13)io->mode7.hoffset;
+  int voffset = (int13)io->mode7.voffset;
 
-  if(io.mode7.vflip) {
+  if(io->mode7.vflip) {
     y_a = 255 - y_a;
     y_b = 255 - y_b;
   }
@@ -158,7 +158,7 @@ auto PPU::Line::renderMode7HD(PPU::IO::Background& self, uint8 source) -> void {
   int pixelYp = INT_MIN;
   for(int ys : range(scale)) {
     float yf = y + ys * 1.0 / scale - 0.5;
-    if(io.mode7.vflip) yf = 255 - yf;
+    if(io->mode7.vflip) yf = 255 - yf;
 
     float a = 1.0 / lerp(y_a, 1.0 / a_a, y_b, 1.0 / a_b, yf);
     float b = 1.0 / lerp(y_a, 1.0 / b_a, y_b, 1.0 / b_b, yf);
@@ -177,7 +177,7 @@ auto PPU::Line::renderMode7HD(PPU::IO::Background& self, uint8 source) -> void {
 
       for(int xs : range(scale)) {
         float xf = x + xs * 1.0 / scale - 0.5;
-        if(io.mode7.hflip) xf = 255 - xf;
+        if(io->mode7.hflip) xf = 255 - xf;
 
         int pixelX = (originX + a * xf) / 256;
         int pixelY = (originY + c * xf) / 256;
@@ -187,8 +187,8 @@ auto PPU::Line::renderMode7HD(PPU::IO::Background& self, uint8 source) -> void {
 
         //only compute color again when coordinates have changed
         if(pixelX != pixelXp || pixelY != pixelYp) {
-          uint tile    = io.mode7.repeat == 3 && ((pixelX | pixelY) & ~1023) ? 0 : (ppu.vram[(pixelY >> 3 & 127) * 128 + (pixelX >> 3 & 127)] & 0xff);
-          uint palette = io.mode7.repeat == 2 && ((pixelX | pixelY) & ~1023) ? 0 : (ppu.vram[(((pixelY & 7) << 3) + (pixelX & 7)) + (tile << 6)] >> 8);
+          uint tile    = io->mode7.repeat == 3 && ((pixelX | pixelY) & ~1023) ? 0 : (ppu.vram[(pixelY >> 3 & 127) * 128 + (pixelX >> 3 & 127)] & 0xff);
+          uint palette = io->mode7.repeat == 2 && ((pixelX | pixelY) & ~1023) ? 0 : (ppu.vram[(((pixelY & 7) << 3) + (pixelX & 7)) + (tile << 6)] >> 8);
 
           uint8 priority;
           if(!extbg) {
@@ -200,7 +200,7 @@ auto PPU::Line::renderMode7HD(PPU::IO::Background& self, uint8 source) -> void {
           if(!palette) continue;
 
           uint16 color;
-          if(io.col.directColor && !extbg) {
+          if(io->col.directColor && !extbg) {
             color = directColor(0, palette);
           } else {
             color = cgram[palette];
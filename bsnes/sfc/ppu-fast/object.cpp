@@ -1,4 +1,4 @@
-auto PPU::Line::renderObject(PPU::IO::Object& self) -> void {
+auto PPU::Line::renderObject(const PPU::IO::Object& self) -> void {
   if(!self.aboveEnable && !self.belowEnable) return;
 
   bool windowAbove[256];
@@ -209,6 +209,7 @@ auto PPU::Line::renderObject(PPU::IO::Object& self) -> void {
 }
 
 auto PPU::oamAddressReset() -> void {
+  snapshots.ioDirty = true;
   io.oamAddress = io.oamBaseAddress;
   oamSetFirstObject();
 }
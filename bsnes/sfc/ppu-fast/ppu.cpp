@@ -11,6 +11,7 @@ PPU& ppubase = ppu;
 PPU ppu;
 #include "io.cpp"
 #include "line.cpp"
+#include "line-queue.cpp"
 #include "background.cpp"
 #include "mode7.cpp"
 #include "mode7hd.cpp"
@@ -44,9 +45,7 @@ static auto naturalOr(const char *a, const F &b) -> unsigned int {
   return astr.natural();
 }
 
-PPU::PPU()
-  : threadPool()
-{
+PPU::PPU() {
   output = new uint16_t[2304 * 2160]();
 
   for(uint l : range(16)) {
@@ -64,8 +63,11 @@ PPU::PPU()
     }
   }
 
+  snapshots.reset();
   for(uint y : range(240)) {
     lines[y].y = y;
+    lines[y].io = &snapshots.disabled;
+    lines[y].cgram = cgram;
   }
 }
 
@@ -102,9 +104,11 @@ auto PPU::main() -> void {
       if(y == 1) {
         io.mosaic.counter = mosaicEnable ? io.mosaic.size + 1 : 0;
       }
+      uint mosaicCounter = io.mosaic.counter;
       if(io.mosaic.counter && !--io.mosaic.counter) {
         io.mosaic.counter = mosaicEnable ? io.mosaic.size + 0 : 0;
       }
+      if(io.mosaic.counter != mosaicCounter) snapshots.ioDirty = true;
       lines[y].cache();
     }
   }
@@ -114,6 +118,8 @@ auto PPU::main() -> void {
 
 auto PPU::scanline() -> void {
   if(vcounter() == 0) {
+    snapshots.ioDirty = true;
+
     if(latch.overscan && !io.overscan) {
       //when disabling overscan, clear the overscan area that won't be rendered to:
       for(uint y = 1; y <= 240; y++) {
@@ -148,7 +154,8 @@ auto PPU::scanline() -> void {
 
   if(vcounter() == 240) {
     Line::flush();
-    threadPool.resize(configuration.hacks.ppu.threads);
+    snapshots.reset();
+    lineQueue.resize(configuration.hacks.ppu.threads);
   }
 }
 
@@ -215,6 +222,7 @@ auto PPU::power(bool reset) -> void {
     for(auto& color : cgram) color = 0x0000;
     for(auto& object : objects) object = {};
   }
+  vramPages.markAll();
 
   latch = {};
   io = {};
@@ -225,6 +233,8 @@ auto PPU::power(bool reset) -> void {
 
   Line::start = 0;
   Line::count = 0;
+  Line::flush();
+  snapshots.reset();
 
   frame = {};
 }
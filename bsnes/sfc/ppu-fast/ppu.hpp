@@ -297,6 +297,7 @@ public:
   IO io;
 
   uint16 vram[32 * 1024] = {};
+  DirtyPages vramPages;
   uint16 cgram[256] = {};
   Object objects[128] = {};
   uint8 oam[0x220] = {};
@@ -326,21 +327,21 @@ public:
     alwaysinline auto plotHD(Pixel*, uint x, uint8 source, uint8 priority, uint16 color, bool hires, bool subpixel) -> void;
 
     //background.cpp
-    auto renderBackground(PPU::IO::Background&, uint8 source) -> void;
+    auto renderBackground(const PPU::IO::Background&, uint8 source) -> void;
     template<uint8 bgMode, uint8 tMode>
-    auto _renderBackgroundTileMode(PPU::IO::Background&, uint8 source) -> void;
+    auto _renderBackgroundTileMode(const PPU::IO::Background&, uint8 source) -> void;
 
     //mode7.cpp
-    auto renderMode7(PPU::IO::Background&, uint8 source) -> void;
+    auto renderMode7(const PPU::IO::Background&, uint8 source) -> void;
 
     //mode7hd.cpp
     static auto cacheMode7HD() -> void;
-    auto renderMode7HD(PPU::IO::Background&, uint8 source) -> void;
+    auto renderMode7HD(const PPU::IO::Background&, uint8 source) -> void;
     alwaysinline auto lerp(float pa, float va, float pb, float vb, float pr) -> float;
 
     //mode7hd-avx2.cpp
     auto renderMode7HD_AVX2(
-      PPU::IO::Background&, uint8 source,
+      const PPU::IO::Background&, uint8 source,
       Pixel* above, Pixel* below,
       bool* windowAbove, bool* windowBelow,
       float originX, float a,
@@ -348,18 +349,18 @@ public:
     ) -> void;
 
     //object.cpp
-    auto renderObject(PPU::IO::Object&) -> void;
+    auto renderObject(const PPU::IO::Object&) -> void;
 
     //window.cpp
-    auto renderWindow(PPU::IO::WindowLayer&, bool enable, bool output[256]) -> void;
-    auto renderWindow(PPU::IO::WindowColor&, uint mask,   bool output[256]) -> void;
+    auto renderWindow(const PPU::IO::WindowLayer&, bool enable, bool output[256]) -> void;
+    auto renderWindow(const PPU::IO::WindowColor&, uint mask,   bool output[256]) -> void;
 
   //unserialized:
     uint y;  //constant
     bool fieldID;
 
-    IO io;
-    uint16 cgram[256];
+    const IO* io;        //shared snapshot of PPU::io taken when this line was cached
+    const uint16* cgram;  //shared snapshot of PPU::cgram taken when this line was cached
 
     ObjectItem items[128+128];  //32 on real hardware
     ObjectTile tiles[128+128];  //34 on real hardware; 1024 max (128 * 64-width tiles)
@@ -375,8 +376,56 @@ public:
     static uint count;
   };
 
+  //line-queue.cpp
+  //lock-free queue of scanlines waiting to be rendered: the PPU thread is the only producer and
+  //any number of workers consume from it. idle workers spin briefly before parking, and wait()
+  //has the PPU thread help render the remaining lines instead of blocking.
+  struct LineQueue {
+    enum class Mode : uint { Even, Odd, Both };
+
+    ~LineQueue();
+    auto resize(uint threads) -> void;
+    auto push(uint y, Mode mode) -> void;
+    auto wait() -> void;
+
+  private:
+    enum : uint { Size = 256, Mask = Size - 1, Spins = 1024 };
+
+    alwaysinline auto pending() const -> bool { return tail.load() != head.load(); }
+    auto run() -> bool;
+    auto worker() -> void;
+    auto stop() -> void;
+
+    uint jobs[Size] = {};  //y | mode << 8
+    std::atomic<uint> head{0};  //next job to be claimed by a consumer
+    std::atomic<uint> tail{0};  //next free slot for the producer
+    std::atomic<uint> done{0};  //jobs finished rendering
+    std::atomic<uint> sleeping{0};
+    std::atomic<bool> quit{false};
+    std::mutex lock;
+    std::condition_variable wake;
+    std::vector<std::thread> workers;
+  };
+
+  //line.cpp
+  //read-only copies of io and cgram shared between scanlines. a new copy is only taken for the
+  //next cached line after the PPU state has changed, rather than copying both for every line.
+  struct Snapshots {
+    auto reset() -> void;
+
+    IO io[240];
+    uint16 cgram[240][256];
+    uint ioCount = 0;
+    uint cgramCount = 0;
+    bool ioDirty = true;
+    bool cgramDirty = true;
+
+    IO disabled;  //shared by all lines with the display disabled
+  };
+
 //unserialized:
   Line lines[240];
+  Snapshots snapshots;
 
   //used to help detect when the video output size changes between frames to clear overscan area.
   struct Frame {
@@ -393,7 +442,7 @@ public:
     int endLerpLine[32];
   } mode7LineGroups;
 
-  thread_pool threadPool;
+  LineQueue lineQueue;
 };
 
 extern PPU ppufast;
@@ -4,12 +4,13 @@ auto PPU::serialize(serializer& s) -> void {
 
   latch.serialize(s);
   io.serialize(s);
-  s.array(vram);
+  vramPages.serialize(s, vram, 32 * 1024);
   s.array(cgram);
   for(auto& object : objects) object.serialize(s);
 
   Line::start = 0;
   Line::count = 0;
+  if(s.mode() == serializer::Load) Line::flush(), snapshots.reset();
 }
 
 auto PPU::Latch::serialize(serializer& s) -> void {
@@ -1,4 +1,4 @@
-auto PPU::Line::renderWindow(PPU::IO::WindowLayer& self, bool enable, bool output[256]) -> void {
+auto PPU::Line::renderWindow(const PPU::IO::WindowLayer& self, bool enable, bool output[256]) -> void {
   if(!enable || (!self.oneEnable && !self.twoEnable)) {
     memory::fill<bool>(output, 256, 0);
     return;
@@ -7,7 +7,7 @@ auto PPU::Line::renderWindow(PPU::IO::WindowLayer& self, bool enable, bool outpu
   if(self.oneEnable && !self.twoEnable) {
     bool set = 1 ^ self.oneInvert, clear = !set;
     for(uint x : range(256)) {
-      output[x] = x >= io.window.oneLeft && x <= io.window.oneRight ? set : clear;
+      output[x] = x >= io->window.oneLeft && x <= io->window.oneRight ? set : clear;
     }
     return;
   }
@@ -15,14 +15,14 @@ auto PPU::Line::renderWindow(PPU::IO::WindowLayer& self, bool enable, bool outpu
   if(self.twoEnable && !self.oneEnable) {
     bool set = 1 ^ self.twoInvert, clear = !set;
     for(uint x : range(256)) {
-      output[x] = x >= io.window.twoLeft && x <= io.window.twoRight ? set : clear;
+      output[x] = x >= io->window.twoLeft && x <= io->window.twoRight ? set : clear;
     }
     return;
   }
 
   for(uint x : range(256)) {
-    bool oneMask = (x >= io.window.oneLeft && x <= io.window.oneRight) ^ self.oneInvert;
-    bool twoMask = (x >= io.window.twoLeft && x <= io.window.twoRight) ^ self.twoInvert;
+    bool oneMask = (x >= io->window.oneLeft && x <= io->window.oneRight) ^ self.oneInvert;
+    bool twoMask = (x >= io->window.twoLeft && x <= io->window.twoRight) ^ self.twoInvert;
     switch(self.mask) {
     case 0: output[x] = (oneMask | twoMask) == 1; break;
     case 1: output[x] = (oneMask & twoMask) == 1; break;
@@ -32,7 +32,7 @@ auto PPU::Line::renderWindow(PPU::IO::WindowLayer& self, bool enable, bool outpu
   }
 }
 
-auto PPU::Line::renderWindow(PPU::IO::WindowColor& self, uint mask, bool output[256]) -> void {
+auto PPU::Line::renderWindow(const PPU::IO::WindowColor& self, uint mask, bool output[256]) -> void {
   bool set, clear;
   switch(mask) {
   case 0: memory::fill<bool>(output, 256, 1); return;  //always
@@ -49,7 +49,7 @@ auto PPU::Line::renderWindow(PPU::IO::WindowColor& self, uint mask, bool output[
   if(self.oneEnable && !self.twoEnable) {
     if(self.oneInvert) set ^= 1, clear ^= 1;
     for(uint x : range(256)) {
-      output[x] = x >= io.window.oneLeft && x <= io.window.oneRight ? set : clear;
+      output[x] = x >= io->window.oneLeft && x <= io->window.oneRight ? set : clear;
     }
     return;
   }
@@ -57,14 +57,14 @@ auto PPU::Line::renderWindow(PPU::IO::WindowColor& self, uint mask, bool output[
   if(self.twoEnable && !self.oneEnable) {
     if(self.twoInvert) set ^= 1, clear ^= 1;
     for(uint x : range(256)) {
-      output[x] = x >= io.window.twoLeft && x <= io.window.twoRight ? set : clear;
+      output[x] = x >= io->window.twoLeft && x <= io->window.twoRight ? set : clear;
     }
     return;
   }
 
   for(uint x : range(256)) {
-    bool oneMask = (x >= io.window.oneLeft && x <= io.window.oneRight) ^ self.oneInvert;
-    bool twoMask = (x >= io.window.twoLeft && x <= io.window.twoRight) ^ self.twoInvert;
+    bool oneMask = (x >= io->window.oneLeft && x <= io->window.oneRight) ^ self.oneInvert;
+    bool twoMask = (x >= io->window.twoLeft && x <= io->window.twoRight) ^ self.twoInvert;
     switch(self.mask) {
     case 0: output[x] = (oneMask | twoMask) == 1 ? set : clear; break;
     case 1: output[x] = (oneMask & twoMask) == 1 ? set : clear; break;
@@ -41,6 +41,7 @@ auto PPU::writeVRAM(bool byte, uint8 data) -> void {
   auto address = addressVRAM();
   if(byte == 0) vram[address] = vram[address] & 0xff00 | data << 0;
   if(byte == 1) vram[address] = vram[address] & 0x00ff | data << 8;
+  vramPages.mark((address & vram.mask) << 1);  //the page actually written, not the mirror addressed
 }
 
 auto PPU::readOAM(uint10 addr) -> uint8 {
@@ -84,13 +84,14 @@ auto PPU::power(bool reset) -> void {
 
   create(Enter, system.cpuFrequency());
   PPUcounter::reset();
-  memory::fill<uint16>(output, 512 * 480);
+  memory::fill<uint16>(output, 512 * 512);
 
   function<uint8 (uint, uint8)> reader{&PPU::readIO, this};
   function<void  (uint, uint8)> writer{&PPU::writeIO, this};
   bus.map(reader, writer, "00-3f,80-bf:2100-213f");
 
   if(!reset) random.array((uint8*)vram.data, sizeof(vram.data));
+  vramPages.markAll();
 
   ppu1.mdr = random.bias(0xff);
   ppu2.mdr = random.bias(0xff);
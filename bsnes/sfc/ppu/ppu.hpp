@@ -51,8 +51,9 @@ private:
     uint16 data[64 * 1024];
     uint16 mask = 0x7fff;
   } vram;
+  DirtyPages vramPages;
 
-  uint16 output[512 * 480];
+  uint16 output[512 * 512];  //480 lines are displayed; Screen::scanline() addresses up to line 495
   uint16 lightTable[16][32768];
 
   struct {
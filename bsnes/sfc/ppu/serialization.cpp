@@ -11,7 +11,7 @@ auto PPU::serialize(serializer& s) -> void {
   PPUcounter::serialize(s);
 
   s.integer(vram.mask);
-  s.array(vram.data, vram.mask + 1);
+  vramPages.serialize(s, vram.data, vram.mask + 1);
 
   s.integer(ppu1.version);
   s.integer(ppu1.mdr);
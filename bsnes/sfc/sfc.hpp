@@ -35,19 +35,58 @@ namespace SuperFamicom {
     cothread_t active = nullptr;
     bool desynchronized = false;
 
+    //optional instrumentation (system/profiler.cpp): while enabled, every cothread switch is counted,
+    //and the host time and emulated clocks of each component are accumulated until the end of the frame.
+    struct Profiler {
+      enum Component : uint {
+        Host, CPU, SMP, PPU, SA1, SuperFX, ArmDSP, HitachiDSP, NECDSP,
+        ICD, MSU1, Event, SharpRTC, EpsonRTC, SPC7110, BSMemory, Script, Components,
+      };
+      static const char* Names[Components];
+
+      struct Stats {
+        auto nanoseconds() const -> uint64_t;
+
+        uint64_t time[Components] = {};      //host nanoseconds; script time is not counted toward its caller
+        uint64_t clocks[Components] = {};    //emulated clocks, at the rate of each component
+        uint64_t switches[Components][Components] = {};  //[from][to]
+      };
+
+      auto setEnabled(bool enabled) -> void;
+      auto transfer(cothread_t thread) -> void;
+      auto frame() -> void;
+
+      bool enabled = false;
+      Stats current;
+      Stats last;  //the most recently completed frame
+
+    private:
+      auto component(cothread_t thread) const -> uint;
+      auto clock(uint component) const -> int64_t;
+      auto account(uint64_t timestamp) -> void;
+
+      uint active = Host;
+      uint64_t timestamp = 0;
+      uint64_t scriptTime = 0;
+      int64_t activeClock = 0;
+    } profiler;
+
     auto enter() -> void {
       host = co_active();
+      if(profiler.enabled) profiler.transfer(active);
       co_switch(active);
     }
 
     auto leave(Event event_) -> void {
       event = event_;
       active = co_active();
+      if(profiler.enabled) profiler.transfer(host);
       co_switch(host);
     }
 
     auto resume(cothread_t thread) -> void {
       if(mode == Mode::Synchronize) desynchronized = true;
+      if(profiler.enabled) profiler.transfer(thread);
       co_switch(thread);
     }
 
@@ -142,6 +181,7 @@ namespace SuperFamicom {
     struct PPUAccess;
     struct GUI;
     struct PostFrame;
+    struct WriteBatch;
     namespace Net {
       struct Socket;
     }
@@ -154,6 +194,13 @@ namespace SuperFamicom {
 
     vector<ScriptInterface::Net::Socket*> sockets;
 
+    // buffered write interceptors are delivered to the script once per scanline or once per frame:
+    vector<ScriptInterface::WriteBatch*> write_batches;
+    auto flushWriteBatches(bool frame) -> void;
+
+    // the built-in usb2snes server answers its clients once per frame, or once per idle call while paused:
+    auto serveUsb2snes() -> void;
+
     struct {
       asIScriptFunction *init = nullptr;
       asIScriptFunction *unload = nullptr;
@@ -28,6 +28,7 @@ auto SMP::readIO(uint16 address) -> uint8 {
 
   case 0xf3:  //DSPDATA
     //0x80-0xff are read-only mirrors of 0x00-0x7f
+    synchronizeDSP();
     return dsp.read(io.dspAddr & 0x7f);
 
   case 0xf4:  //CPUIO0
@@ -6,7 +6,10 @@ auto SMP::readRAM(uint16 address) -> uint8 {
 
 auto SMP::writeRAM(uint16 address, uint8 data) -> void {
   //writes to $ffc0-$ffff always go to apuram, even if the iplrom is enabled
-  if(io.ramWritable && !io.ramDisable) dsp.apuram[address] = data;
+  if(io.ramWritable && !io.ramDisable) {
+    dsp.apuram[address] = data;
+    dsp.apuramPages.mark(address);
+  }
 }
 
 auto SMP::idle() -> void {
@@ -24,6 +27,7 @@ auto SMP::read(uint16 address) -> uint8 {
     return data;
   } else {
     wait(address, 0);
+    if(dsp.echoes(address)) synchronizeDSP();
     uint8 data = readRAM(address);
     if((address & 0xfff0) == 0x00f0) data = readIO(address);
     return data;
@@ -32,6 +36,8 @@ auto SMP::read(uint16 address) -> uint8 {
 
 auto SMP::write(uint16 address, uint8 data) -> void {
   wait(address);
+  //the DSP may be reading any of APU RAM, and IO writes include its registers
+  synchronizeDSP();
   writeRAM(address, data);  //even IO writes affect underlying RAM
   if((address & 0xfff0) == 0x00f0) writeIO(address, data);
 }
@@ -13,7 +13,7 @@ auto SMP::synchronizeCPU() -> void {
 }
 
 auto SMP::synchronizeDSP() -> void {
-  while(dsp.clock < 0) dsp.main();
+  if(dsp.clock < 0) dsp.main();
 }
 
 auto SMP::Enter() -> void {
@@ -0,0 +1,96 @@
+const char* Scheduler::Profiler::Names[Components] = {
+  "host", "cpu", "smp", "ppu", "sa1", "superfx", "armdsp", "hitachidsp", "necdsp",
+  "icd", "msu1", "event", "sharprtc", "epsonrtc", "spc7110", "bsmemory", "script",
+};
+
+//the host and script components do not have threads of their own
+static auto profilerThread(uint component) -> Thread* {
+  using Profiler = Scheduler::Profiler;
+  switch(component) {
+  case Profiler::CPU: return &cpu;
+  case Profiler::SMP: return &smp;  //includes the DSP, which runs on the SMP thread
+  case Profiler::PPU: return &ppu;
+  case Profiler::SA1: return &sa1;
+  case Profiler::SuperFX: return &superfx;
+  case Profiler::ArmDSP: return &armdsp;
+  case Profiler::HitachiDSP: return &hitachidsp;
+  case Profiler::NECDSP: return &necdsp;
+  case Profiler::ICD: return &icd;
+  case Profiler::MSU1: return &msu1;
+  case Profiler::Event: return &event;
+  case Profiler::SharpRTC: return &sharprtc;
+  case Profiler::EpsonRTC: return &epsonrtc;
+  case Profiler::SPC7110: return &spc7110;
+  case Profiler::BSMemory: return &bsmemory;
+  }
+  return nullptr;
+}
+
+auto Scheduler::Profiler::Stats::nanoseconds() const -> uint64_t {
+  uint64_t sum = 0;
+  for(auto t : time) sum += t;
+  return sum;
+}
+
+auto Scheduler::Profiler::setEnabled(bool enabled_) -> void {
+  if(enabled == enabled_) return;
+  enabled = enabled_;
+  platform->scriptEngineState.timing.enabled = enabled;
+  current = {};
+  last = {};
+  if(!enabled) return;
+
+  //this may be called from a script running on any thread
+  active = component(co_active());
+  timestamp = chrono::nanosecond();
+  scriptTime = platform->scriptEngineState.timing.nanoseconds;
+  activeClock = clock(active);
+}
+
+//called immediately before switching to another thread
+auto Scheduler::Profiler::transfer(cothread_t thread) -> void {
+  account(chrono::nanosecond());
+  uint next = component(thread);
+  current.switches[active][next]++;
+  active = next;
+  activeClock = clock(active);
+}
+
+//called by the host at the end of every displayed frame
+auto Scheduler::Profiler::frame() -> void {
+  account(chrono::nanosecond());
+  activeClock = clock(active);
+  last = current;
+  current = {};
+}
+
+auto Scheduler::Profiler::component(cothread_t thread) const -> uint {
+  //the CPU, SMP and PPU are checked first, as they account for nearly every switch
+  if(thread == cpu.thread) return CPU;
+  if(thread == smp.thread) return SMP;
+  if(thread == ppu.thread) return PPU;
+  for(uint n : range(SA1, Script)) {
+    if(thread == profilerThread(n)->thread) return n;
+  }
+  return Host;
+}
+
+//emulated clocks are only read while the component is active, when no other thread modifies them:
+//the CPU is the reference clock, so its progress is measured by how far the PPU falls behind.
+auto Scheduler::Profiler::clock(uint component) const -> int64_t {
+  if(component == CPU) return -ppu.clock;
+  if(component == PPU) return ppu.clock;
+  if(auto thread = profilerThread(component)) return thread->clock / (int64_t)cpu.frequency;
+  return 0;
+}
+
+auto Scheduler::Profiler::account(uint64_t timestamp_) -> void {
+  auto& timing = platform->scriptEngineState.timing;
+  uint64_t elapsed = timestamp_ - timestamp;
+  uint64_t script = min(elapsed, timing.nanoseconds - scriptTime);
+  current.time[active] += elapsed - script;
+  current.time[Script] += script;
+  current.clocks[active] += clock(active) - activeClock;
+  timestamp = timestamp_;
+  scriptTime = timing.nanoseconds;
+}
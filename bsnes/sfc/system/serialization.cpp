@@ -22,6 +22,42 @@ auto System::serialize(bool synchronize) -> serializer {
   return s;
 }
 
+//incremental serialization: produces the same state as serialize(false),
+//but rewrites a state previously captured by this function in place, copying only
+//the WRAM, VRAM and APU RAM pages that were written since it was captured.
+//generation identifies the captured state; pass 0 (or any new serializer) to capture a full state.
+auto System::serialize(serializer& s, uint& generation) -> bool {
+  if(!co_serializable()) return false;  //incremental states are always unsynchronized
+
+  uint signature = 0x31545342;
+  uint serializeSize = information.serializeSize[0];
+  if(!serializeSize) return false;  //should never occur
+  char version[16] = {};
+  char description[512] = {};
+  bool synchronize = false;
+  memory::copy(&version, (const char*)Emulator::SerializerVersion, Emulator::SerializerVersion.size());
+
+  if(s.capacity() != serializeSize || !generation || generation >= DirtyPages::generation) {
+    s = serializer(serializeSize);
+    generation = 0;
+  } else {
+    s.setMode(serializer::Save);
+  }
+
+  DirtyPages::base = generation;
+  s.integer(signature);
+  s.integer(serializeSize);
+  s.array(version);
+  s.array(description);
+  s.boolean(synchronize);
+  s.boolean(hacks.fastPPU);
+  serializeAll(s, synchronize);
+  DirtyPages::base = 0;
+
+  generation = DirtyPages::generation++;
+  return true;
+}
+
 auto System::unserialize(serializer& s) -> bool {
   uint signature = 0;
   uint serializeSize = 0;
@@ -47,6 +83,19 @@ auto System::unserialize(serializer& s) -> bool {
   return true;
 }
 
+//incremental restore: loads a state captured by serialize(s, generation),
+//copying back only the WRAM, VRAM and APU RAM pages that were written since it was captured.
+//the state remains valid for further incremental serialization and restores afterward.
+auto System::unserialize(serializer& s, uint generation) -> bool {
+  if(!generation || generation >= DirtyPages::generation) return false;
+
+  s.setMode(serializer::Load);
+  DirtyPages::base = generation;
+  bool result = unserialize(s);
+  DirtyPages::base = 0;
+  return result;
+}
+
 //internal
 
 auto System::serializeAll(serializer& s, bool synchronize) -> void {
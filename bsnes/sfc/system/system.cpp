@@ -8,6 +8,7 @@ Random random;
 Cheat cheat;
 Script script;
 #include "serialization.cpp"
+#include "profiler.cpp"
 
 auto System::run() -> void {
   scheduler.mode = Scheduler::Mode::Run;
@@ -103,7 +104,10 @@ auto System::runToSaveStrict() -> void {
   }
 }
 
+//pre_frame() and pre_nmi() run on every frame, speculative or not, so that memory patches made by scripts apply
+//to every frame that is emulated; post_frame() runs only on the frame that is displayed (see PPU::refresh).
 auto System::frameStartEvent() -> void {
+  if(!speculative) script.serveUsb2snes();
   // [jsd] run AngelScript pre_frame() function if available:
   platform->scriptInvokeFunction(script.funcs.pre_frame);
 }
@@ -114,6 +118,15 @@ auto System::framePreNMIEvent() -> void {
 }
 
 auto System::frameEvent() -> void {
+  frameCount++;
+
+  //run-ahead frames are counted toward the frame that is displayed
+  if(scheduler.profiler.enabled && !speculative) scheduler.profiler.frame();
+
+  //deliver the rest of this frame's audio before its video
+  smp.synchronizeDSP();
+  dsp.flush();
+  Emulator::audio.process();
   ppu.refresh();
 
   //refresh all cheat codes once per frame
@@ -23,11 +23,15 @@ struct System {
 
   //serialization.cpp
   auto serialize(bool synchronize) -> serializer;
+  auto serialize(serializer& s, uint& generation) -> bool;
   auto unserialize(serializer&) -> bool;
+  auto unserialize(serializer& s, uint generation) -> bool;
 
   uint frameSkip = 0;
   uint frameCounter = 0;
   bool runAhead = 0;
+  bool speculative = 0;  //frame will be discarded: no audio output
+  uint64 frameCount = 0;  //frames completed by run(); not part of the state
 
 private:
   Emulator::Interface* interface = nullptr;
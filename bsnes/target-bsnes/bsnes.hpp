@@ -12,6 +12,7 @@ extern unique_pointer<Emulator::Interface> emulator;
 
 #include <filter/filter.hpp>
 #include <lzma/lzma.hpp>
+#include <heuristics/database.hpp>
 
 #include <nall/instance.hpp>
 #include <nall/decode/rle.hpp>
@@ -20,6 +21,10 @@ extern unique_pointer<Emulator::Interface> emulator;
 #include <nall/encode/zip.hpp>
 #include <nall/hash/crc16.hpp>
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 #include "program/program.hpp"
 #include "input/input.hpp"
 #include "presentation/presentation.hpp"
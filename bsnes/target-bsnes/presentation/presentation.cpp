@@ -168,10 +168,21 @@ auto Presentation::create() -> void {
   moviePlay.setIcon(Icon::Media::Play).setText("Play").onActivate([&] { program.moviePlay(); });
   movieRecord.setIcon(Icon::Media::Record).setText("Record").onActivate([&] { program.movieRecord(false); });
   movieRecordFromBeginning.setIcon(Icon::Media::Record).setText("Reset and Record").onActivate([&] { program.movieRecord(true); });
+  movieSeek.setIcon(Icon::Media::Next).setText("Seek ...").onActivate([&] {
+    auto frame = NameDialog()
+    .setTitle("Seek Movie")
+    .setText({"Frame number (0 - ", program.movie.frames.size() - 1, "):"})
+    .setAlignment(*this)
+    .create();
+    if(frame) program.movieSeek(frame.natural());
+  });
   movieStop.setIcon(Icon::Media::Stop).setText("Stop").onActivate([&] { program.movieStop(); });
   captureScreenshot.setIcon(Icon::Emblem::Image).setText("Capture Screenshot").onActivate([&] {
     program.captureScreenshot();
   });
+  showProfiler.setText("Show Profiler").onToggle([&] {
+    emulator->setProfiling(showProfiler.checked());
+  });
   cheatFinder.setIcon(Icon::Action::Search).setText("Cheat Finder ...").onActivate([&] { toolsWindow.show(0); });
   cheatEditor.setIcon(Icon::Edit::Replace).setText("Cheat Editor ...").onActivate([&] { toolsWindow.show(1); });
   stateManager.setIcon(Icon::Application::FileManager).setText("State Manager ...").onActivate([&] { toolsWindow.show(2); });
@@ -110,8 +110,10 @@ struct Presentation : Window {
         MenuItem moviePlay{&movieMenu};
         MenuItem movieRecord{&movieMenu};
         MenuItem movieRecordFromBeginning{&movieMenu};
+        MenuItem movieSeek{&movieMenu};
         MenuItem movieStop{&movieMenu};
       MenuItem captureScreenshot{&toolsMenu};
+      MenuCheckItem showProfiler{&toolsMenu};
       MenuSeparator toolsSeparatorC{&toolsMenu};
       MenuItem cheatFinder{&toolsMenu};
       MenuItem cheatEditor{&toolsMenu};
@@ -20,6 +20,9 @@ auto Program::load() -> void {
   emulator->configure("Hacks/Coprocessor/DelayedSync", settings.emulator.hack.coprocessor.delayedSync);
   emulator->configure("Hacks/Coprocessor/PreferHLE", settings.emulator.hack.coprocessor.preferHLE);
   emulator->configure("Hacks/SuperFX/Overclock", settings.emulator.hack.superfx.overclock);
+  emulator->configure("Network/Usb2snes/Enable", settings.network.usb2snes.enable);
+  emulator->configure("Network/Usb2snes/Host", settings.network.usb2snes.host);
+  emulator->configure("Network/Usb2snes/Port", settings.network.usb2snes.port);
   if(!emulator->load()) return;
 
   gameQueue = {};
@@ -131,8 +134,8 @@ auto Program::loadSuperFamicom(string location) -> bool {
   auto sha256 = Hash::SHA256(rom).digest();
   superFamicom.title = heuristics.title();
   superFamicom.region = heuristics.videoRegion();
-  if(auto document = BML::unserialize(string::read(locate("Database/Super Famicom.bml")))) {
-    if(auto game = document[{"game(sha256=", sha256, ")"}]) {
+  if(databases.superFamicom.open(locate("Database/Super Famicom.bml"))) {
+    if(auto game = databases.superFamicom.find(sha256)) {
       manifest = BML::serialize(game);
       //the internal ROM header title is not present in the database, but is needed for internal core overrides
       manifest.append("  title: ", superFamicom.title, "\n");
@@ -185,14 +188,14 @@ auto Program::loadGameBoy(string location) -> bool {
   gameBoy.patched = applyPatchIPS(rom, location) || applyPatchBPS(rom, location);
   auto heuristics = Heuristics::GameBoy(rom, location);
   auto sha256 = Hash::SHA256(rom).digest();
-  if(auto document = BML::unserialize(string::read(locate("Database/Game Boy.bml")))) {
-    if(auto game = document[{"game(sha256=", sha256, ")"}]) {
+  if(databases.gameBoy.open(locate("Database/Game Boy.bml"))) {
+    if(auto game = databases.gameBoy.find(sha256)) {
       manifest = BML::serialize(game);
       gameBoy.verified = true;
     }
   }
-  if(auto document = BML::unserialize(string::read(locate("Database/Game Boy Color.bml")))) {
-    if(auto game = document[{"game(sha256=", sha256, ")"}]) {
+  if(databases.gameBoyColor.open(locate("Database/Game Boy Color.bml"))) {
+    if(auto game = databases.gameBoyColor.find(sha256)) {
       manifest = BML::serialize(game);
       gameBoy.verified = true;
     }
@@ -222,8 +225,8 @@ auto Program::loadBSMemory(string location) -> bool {
   bsMemory.patched = applyPatchIPS(rom, location) || applyPatchBPS(rom, location);
   auto heuristics = Heuristics::BSMemory(rom, location);
   auto sha256 = Hash::SHA256(rom).digest();
-  if(auto document = BML::unserialize(string::read(locate("Database/BS Memory.bml")))) {
-    if(auto game = document[{"game(sha256=", sha256, ")"}]) {
+  if(databases.bsMemory.open(locate("Database/BS Memory.bml"))) {
+    if(auto game = databases.bsMemory.find(sha256)) {
       manifest = BML::serialize(game);
       bsMemory.verified = true;
     }
@@ -252,8 +255,8 @@ auto Program::loadSufamiTurboA(string location) -> bool {
   sufamiTurboA.patched = applyPatchIPS(rom, location) || applyPatchBPS(rom, location);
   auto heuristics = Heuristics::SufamiTurbo(rom, location);
   auto sha256 = Hash::SHA256(rom).digest();
-  if(auto document = BML::unserialize(string::read(locate("Database/Sufami Turbo.bml")))) {
-    if(auto game = document[{"game(sha256=", sha256, ")"}]) {
+  if(databases.sufamiTurbo.open(locate("Database/Sufami Turbo.bml"))) {
+    if(auto game = databases.sufamiTurbo.find(sha256)) {
       manifest = BML::serialize(game);
       sufamiTurboA.verified = true;
     }
@@ -282,8 +285,8 @@ auto Program::loadSufamiTurboB(string location) -> bool {
   sufamiTurboB.patched = applyPatchIPS(rom, location) || applyPatchBPS(rom, location);
   auto heuristics = Heuristics::SufamiTurbo(rom, location);
   auto sha256 = Hash::SHA256(rom).digest();
-  if(auto document = BML::unserialize(string::read(locate("Database/Sufami Turbo.bml")))) {
-    if(auto game = document[{"game(sha256=", sha256, ")"}]) {
+  if(databases.sufamiTurbo.open(locate("Database/Sufami Turbo.bml"))) {
+    if(auto game = databases.sufamiTurbo.find(sha256)) {
       manifest = BML::serialize(game);
       sufamiTurboB.verified = true;
     }
@@ -325,6 +328,8 @@ auto Program::unload() -> void {
   if(emulatorSettings.autoSaveStateOnUnload.checked()) {
     saveUndoState();
   }
+  stateWriter.flush();  //states must be written before the game's paths are released
+  writeStates();
   emulator->unload();
   showMessage("Game unloaded");
   superFamicom = {};
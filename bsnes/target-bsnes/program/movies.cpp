@@ -1,21 +1,32 @@
+//BSV1: "BSV1", state size, state, then one 16-bit word per input poll.
+//BSV2: "BSV2", state size, state, frame count, then input blocks:
+//  each block holds a repeat count, a poll count and the polls of one frame,
+//  which repeat unchanged for that many consecutive frames.
+//  keyframes follow (frame, size, RLE-compressed state), one every KeyframeInterval frames,
+//  then an index (keyframe count, then frame and file offset per keyframe),
+//  and finally a trailer: the index offset (64-bit) and "BSVI".
+
 auto Program::movieMode(Movie::Mode mode) -> void {
   movie.mode = mode;
 
   if(movie.mode == Movie::Mode::Inactive) {
     presentation.moviePlay.setEnabled(true);
     presentation.movieRecord.setEnabled(true);
+    presentation.movieSeek.setEnabled(false);
     presentation.movieStop.setEnabled(false);
   }
 
   if(movie.mode == Movie::Mode::Playing) {
     presentation.moviePlay.setEnabled(false);
     presentation.movieRecord.setEnabled(false);
+    presentation.movieSeek.setEnabled((bool)movie.frames);  //BSV1 movies cannot seek
     presentation.movieStop.setEnabled(true);
   }
 
   if(movie.mode == Movie::Mode::Recording) {
     presentation.moviePlay.setEnabled(false);
     presentation.movieRecord.setEnabled(false);
+    presentation.movieSeek.setEnabled(false);
     presentation.movieStop.setEnabled(true);
   }
 }
@@ -31,34 +42,97 @@ auto Program::moviePlay() -> void {
       if(fp.read() != 'B') failed = true;
       if(fp.read() != 'S') failed = true;
       if(fp.read() != 'V') failed = true;
-      if(fp.read() != '1') failed = true;
-      if(uint32_t size = fp.readl(4L)) {
-        if(fp.size() - fp.offset() < size) failed = true;
-        if(!failed) {
-          auto data = new uint8_t[size];
-          fp.read({data, size});
-          serializer s{data, size};
-          if(!emulator->unserialize(s)) failed = true;
-        }
+      auto version = fp.read();
+      movie.location = location;
+      if(failed || !movieRead(fp, version)) {
+        movie.state = {};
+        movie.input.reset();
+        movie.frames.reset();
+        movie.keyframes.reset();
+        showMessage("Movie format not supported");
       } else {
-        //entropy can desync movies recorded without save states
-        emulator->configure("Hacks/Entropy", "None");
-        emulator->power();
-      }
-      if(!failed) {
         movieMode(Movie::Mode::Playing);
-        movie.input.reset();
-        while(fp.size() - fp.offset() >= 2) {
-          movie.input.append(fp.readl(2L));
-        }
         showMessage("Movie playback started");
-      } else {
-        showMessage("Movie format not supported");
       }
     }
   }
 }
 
+auto Program::movieRead(file_buffer& fp, uint8_t version) -> bool {
+  if(version != '1' && version != '2') return false;
+
+  movie.state = {};
+  movie.input.reset();
+  movie.frames.reset();
+  movie.keyframes.reset();
+  movie.position = 0;
+  movie.frame = 0;
+  movie.frameCount = ~0ull;
+
+  uint32_t size = fp.readl(4L);
+  if(fp.size() - fp.offset() < size) return false;
+  if(size) {
+    vector<uint8_t> data;
+    data.resize(size);
+    fp.read({data.data(), size});
+    movie.state = serializer{data.data(), size};
+  }
+  if(!movieRestart()) return false;
+
+  if(version == '1') {
+    while(fp.size() - fp.offset() >= 2) {
+      movie.input.append(fp.readl(2L));
+    }
+    return (bool)movie.input;
+  }
+
+  uint32_t frames = fp.readl(4L);
+  vector<int16> polls;
+  while(movie.frames.size() < frames) {
+    if(fp.size() - fp.offset() < 6) return false;
+    uint32_t repeat = fp.readl(4L);
+    uint16_t count = fp.readl(2L);
+    if(!repeat || repeat > frames - movie.frames.size()) return false;
+    if(fp.size() - fp.offset() < count * 2) return false;
+    polls.reset();
+    for(uint n : range(count)) polls.append(fp.readl(2L));
+    while(repeat--) {
+      movie.frames.append(movie.input.size());
+      movie.input.append(polls);
+    }
+  }
+
+  if(fp.size() < fp.offset() + 12) return false;
+  fp.seek(fp.size() - 12);
+  uint64_t index = fp.readl(8L);
+  if(fp.read() != 'B' || fp.read() != 'S' || fp.read() != 'V' || fp.read() != 'I') return false;
+  if(index + 4 > fp.size() - 12) return false;
+  fp.seek(index);
+  uint32_t keyframes = fp.readl(4L);
+  if(keyframes * 12ull > fp.size() - 12 - fp.offset()) return false;
+  for(uint n : range(keyframes)) {
+    Movie::Keyframe keyframe;
+    keyframe.frame = fp.readl(4L);
+    keyframe.offset = fp.readl(8L);
+    if(keyframe.frame >= movie.frames.size() || keyframe.offset >= index) return false;
+    if(movie.keyframes && keyframe.frame <= movie.keyframes.last().frame) return false;
+    movie.keyframes.append(keyframe);
+  }
+  return (bool)movie.input;
+}
+
+//returns to the state the movie was started from
+auto Program::movieRestart() -> bool {
+  if(!movie.state.capacity()) {
+    //entropy can desync movies recorded without save states
+    emulator->configure("Hacks/Entropy", "None");
+    emulator->power();
+    return true;
+  }
+  serializer s{movie.state.data(), movie.state.capacity()};
+  return emulator->unserialize(s);
+}
+
 auto Program::movieRecord(bool fromBeginning) -> void {
   if(movie.mode == Movie::Mode::Inactive) {
     movieMode(Movie::Mode::Recording);
@@ -71,10 +145,85 @@ auto Program::movieRecord(bool fromBeginning) -> void {
       movie.state = emulator->serialize();
     }
     movie.input.reset();
+    movie.frames.reset();
+    movie.keyframes.reset();
+    movie.frame = 0;
+    movie.frameCount = ~0ull;
     showMessage("Movie recording started");
   }
 }
 
+//called before each run(). run() returns at every scheduler event, so a frame takes several calls:
+//a movie frame only begins once the emulator has completed the previous one
+auto Program::movieFrame() -> void {
+  if(movie.mode == Movie::Mode::Inactive) return;
+  auto frameCount = emulator->frameCount();
+  if(frameCount == movie.frameCount) return;
+  movie.frameCount = frameCount;
+
+  if(movie.mode == Movie::Mode::Recording) {
+    if(movie.frame && movie.frame % Movie::KeyframeInterval == 0) {
+      //unsynchronized, so that capturing a keyframe does not alter the emulation being recorded
+      auto state = emulator->serialize(0);
+      Movie::Keyframe keyframe;
+      keyframe.frame = movie.frame;
+      keyframe.data = Encode::RLE<1>({state.data(), state.size()});
+      movie.keyframes.append(keyframe);
+    }
+    movie.frames.append(movie.input.size());
+    movie.frame++;
+  }
+
+  if(movie.mode == Movie::Mode::Playing) {
+    movie.frame++;
+  }
+}
+
+//loads the nearest keyframe at or before the requested frame, then replays forward to it
+auto Program::movieSeek(uint frame) -> bool {
+  if(movie.mode != Movie::Mode::Playing || !movie.frames) return false;
+  if(frame >= movie.frames.size()) return showMessage({"Movie only has ", movie.frames.size(), " frames"}), false;
+
+  const Movie::Keyframe* keyframe = nullptr;
+  for(auto& candidate : movie.keyframes) {
+    if(candidate.frame <= frame) keyframe = &candidate;
+  }
+
+  if(keyframe) {
+    auto fp = file::open(movie.location, file::mode::read);
+    if(!fp) return showMessage("Movie file could not be opened"), false;
+    fp.seek(keyframe->offset);
+    if(fp.readl(4L) != keyframe->frame) return showMessage("Movie keyframe is corrupt"), false;
+    uint32_t size = fp.readl(4L);
+    if(fp.size() - fp.offset() < size) return showMessage("Movie keyframe is corrupt"), false;
+    vector<uint8_t> data;
+    data.resize(size);
+    fp.read({data.data(), size});
+    auto state = Decode::RLE<1>(data);
+    serializer s{state.data(), (uint)state.size()};
+    if(!emulator->unserialize(s)) return showMessage("Movie keyframe is in incompatible format"), false;
+    movie.frame = keyframe->frame;
+  } else {
+    if(!movieRestart()) return showMessage("Movie state is in incompatible format"), false;
+    movie.frame = 0;
+  }
+  movie.position = movie.frames[movie.frame];
+  movie.frameCount = ~0ull;
+
+  //replay forward as fast as possible, until the frame before the requested one has completed
+  video.setBlocking(false);
+  audio.setBlocking(false);
+  while((movie.frame < frame || emulator->frameCount() == movie.frameCount) && movie.mode == Movie::Mode::Playing) {
+    movieFrame();
+    emulator->run();
+  }
+  video.setBlocking(settings.video.blocking);
+  audio.setBlocking(settings.audio.blocking);
+
+  rewindReset();  //do not allow rewinding past a seek
+  return showMessage({"Movie seeked to frame ", frame}), true;
+}
+
 auto Program::movieStop() -> void {
   if(movie.mode == Movie::Mode::Inactive) {
     return;
@@ -88,6 +237,10 @@ auto Program::movieStop() -> void {
     //stop recording more inputs while attempting to save file asynchronously
     movieMode(Movie::Mode::Inactive);
 
+    //any polls made before the first frame began belong to it
+    if(!movie.frames) movie.frames.append(0);
+    movie.frames[0] = 0;
+
     BrowserDialog dialog;
     dialog.setTitle("Save Movie");
     dialog.setPath(Path::desktop());
@@ -98,10 +251,52 @@ auto Program::movieStop() -> void {
         fp.write('B');
         fp.write('S');
         fp.write('V');
-        fp.write('1');
+        fp.write('2');
         fp.writel(movie.state.size(), 4L);
         fp.write({movie.state.data(), movie.state.size()});
-        for(auto& input : movie.input) fp.writel(input, 2L);
+
+        //polls of frame n are input[frames[n]] up to input[frames[n + 1]]
+        auto first = [&](uint frame) -> uint { return movie.frames[frame]; };
+        auto last = [&](uint frame) -> uint {
+          return frame + 1 < movie.frames.size() ? movie.frames[frame + 1] : movie.input.size();
+        };
+        auto same = [&](uint a, uint b) -> bool {
+          if(last(a) - first(a) != last(b) - first(b)) return false;
+          for(uint n : range(last(a) - first(a))) {
+            if(movie.input[first(a) + n] != movie.input[first(b) + n]) return false;
+          }
+          return true;
+        };
+
+        fp.writel(movie.frames.size(), 4L);
+        for(uint frame = 0; frame < movie.frames.size();) {
+          uint repeat = 1;
+          while(frame + repeat < movie.frames.size() && same(frame, frame + repeat)) repeat++;
+          fp.writel(repeat, 4L);
+          fp.writel(last(frame) - first(frame), 2L);
+          for(uint n : range(first(frame), last(frame))) fp.writel(movie.input[n], 2L);
+          frame += repeat;
+        }
+
+        vector<uint64_t> offsets;
+        for(auto& keyframe : movie.keyframes) {
+          offsets.append(fp.offset());
+          fp.writel(keyframe.frame, 4L);
+          fp.writel(keyframe.data.size(), 4L);
+          fp.write(keyframe.data);
+        }
+
+        uint64_t index = fp.offset();
+        fp.writel(movie.keyframes.size(), 4L);
+        for(uint n : range(movie.keyframes.size())) {
+          fp.writel(movie.keyframes[n].frame, 4L);
+          fp.writel(offsets[n], 8L);
+        }
+        fp.writel(index, 8L);
+        fp.write('B');
+        fp.write('S');
+        fp.write('V');
+        fp.write('I');
         showMessage("Movie recorded");
       } else {
         showMessage("Movie could not be recorded");
@@ -114,4 +309,6 @@ auto Program::movieStop() -> void {
   movieMode(Movie::Mode::Inactive);
   movie.state = {};
   movie.input.reset();
+  movie.frames.reset();
+  movie.keyframes.reset();
 }
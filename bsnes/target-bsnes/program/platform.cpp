@@ -5,6 +5,7 @@
 #include <heuristics/game-boy.cpp>
 #include <heuristics/bs-memory.cpp>
 #include <heuristics/sufami-turbo.cpp>
+#include <heuristics/database.cpp>
 
 //ROM data is held in memory to support compressed archives, soft-patching, and game hacks
 auto Program::open(uint id, string name, vfs::file::mode mode, bool required) -> shared_pointer<vfs::file> {
@@ -248,17 +249,17 @@ auto Program::videoFrame(const uint16* data, uint pitch, uint width, uint height
   current = chrono::timestamp();
   if(current != previous) {
     previous = current;
-    showFrameRate({frameCounter * (1 + emulator->frameSkip()), " FPS"});
+    string frameRate{frameCounter * (1 + emulator->frameSkip()), " FPS"};
+    if(emulator->profiling()) frameRate.append(" |", profileStatus());
+    showFrameRate(frameRate);
     frameCounter = 0;
   }
 }
 
-auto Program::audioFrame(const double* samples, uint channels) -> void {
-  if(mute) {
-    double silence[] = {0.0, 0.0};
-    audio.output(silence);
-  } else {
-    audio.output(samples);
+auto Program::audioFrames(const double* samples, uint frames, uint channels) -> void {
+  double silence[] = {0.0, 0.0};
+  for(uint n : range(frames)) {
+    audio.output(mute ? silence : samples + n * channels);
   }
 }
 
@@ -273,10 +274,10 @@ auto Program::inputPoll(uint port, uint device, uint input) -> int16 {
   if(movie.mode == Movie::Mode::Recording) {
     movie.input.append(value);
   } else if(movie.mode == Movie::Mode::Playing) {
-    if(movie.input) {
-      value = movie.input.takeFirst();
+    if(movie.position < movie.input.size()) {
+      value = movie.input[movie.position++];
     }
-    if(!movie.input) {
+    if(movie.position >= movie.input.size()) {
       movieStop();
     }
   }
@@ -66,6 +66,10 @@ auto Program::create() -> void {
   settings.general.crashed = false;
   settings.save();
 
+  //the filter tables are built in the background, rather than by the first frame that uses a filter:
+  std::thread{Filter::initialize}.detach();
+  updateVideoFilter();
+
   driverSettings.videoDriverChanged();
   driverSettings.audioDriverChanged();
   driverSettings.inputDriverChanged();
@@ -94,6 +98,7 @@ auto Program::create() -> void {
 }
 
 auto Program::main() -> void {
+  writeStates();
   updateStatus();
   video.poll();
 
@@ -137,20 +142,32 @@ auto Program::main() -> void {
   }
 
   rewindRun();
+  movieFrame();
 
-  if(!settings.emulator.runAhead.frames || fastForwarding || rewinding) {
+  //run-ahead is not used while a movie records or plays
+  if(!settings.emulator.runAhead.frames || fastForwarding || rewinding || movie.mode != Movie::Mode::Inactive) {
     emulator->run();
   } else {
+    //the first frame is authoritative: it produces audio. the frames after it are speculative and discarded once the
+    //last one has been displayed. script frame hooks run as they did before: pre_frame() and pre_nmi() on every frame,
+    //post_frame() only on the displayed frame, so that it always follows a pre_frame() on the same frame.
     emulator->setRunAhead(true);
     emulator->run();
-    auto state = emulator->serialize(0);
+    //the snapshot is updated in place, copying only the memory pages written since the last frame:
+    bool incremental = emulator->serialize(runAhead.state, runAhead.generation);
+    if(!incremental) runAhead.state = emulator->serialize(0);
+    emulator->setSpeculative(true);
     if(settings.emulator.runAhead.frames >= 2) emulator->run();
     if(settings.emulator.runAhead.frames >= 3) emulator->run();
     if(settings.emulator.runAhead.frames >= 4) emulator->run();
     emulator->setRunAhead(false);
     emulator->run();
-    state.setMode(serializer::Mode::Load);
-    emulator->unserialize(state);
+    emulator->setSpeculative(false);
+    if(!incremental || !emulator->unserialize(runAhead.state, runAhead.generation)) {
+      runAhead.state.setMode(serializer::Mode::Load);
+      emulator->unserialize(runAhead.state);
+      runAhead.generation = 0;
+    }
   }
 
   if(emulatorSettings.autoSaveMemory.checked()) {
@@ -171,6 +188,7 @@ auto Program::quit() -> void {
   settings.general.crashed = false;
 
   unload();
+  stateWriter.stop();
   settings.save();
   video.reset();
   audio.reset();
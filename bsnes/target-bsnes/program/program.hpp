@@ -10,7 +10,7 @@ struct Program : Lock, Emulator::Platform {
   auto open(uint id, string name, vfs::file::mode mode, bool required) -> shared_pointer<vfs::file> override;
   auto load(uint id, string name, string type, vector<string> options = {}) -> Emulator::Platform::Load override;
   auto videoFrame(const uint16* data, uint pitch, uint width, uint height, uint scale) -> void override;
-  auto audioFrame(const double* samples, uint channels) -> void override;
+  auto audioFrames(const double* samples, uint frames, uint channels) -> void override;
   auto inputPoll(uint port, uint device, uint input) -> int16 override;
   auto inputRumble(uint port, uint device, uint input, bool enable) -> void override;
 
@@ -58,34 +58,107 @@ struct Program : Lock, Emulator::Platform {
   auto hasState(string filename) -> bool;
   auto loadStateData(string filename) -> vector<uint8_t>;
   auto loadState(string filename) -> bool;
-  auto saveState(string filename) -> bool;
-  auto saveUndoState() -> bool;
+  auto saveState(string filename, bool wait = false) -> bool;
+  auto saveUndoState(bool wait = false) -> bool;
   auto saveRedoState() -> bool;
   auto removeState(string filename) -> bool;
   auto renameState(string from, string to) -> bool;
+  auto writeStates() -> void;
+
+  //save states are captured on the emulation thread, then compressed and written by a worker thread
+  struct StateWrite {
+    string filename;   //eg "Quick/Slot 1"
+    string statePath;  //captured when queued, in case the game is unloaded before the write completes
+    bool folder = false;  //true = one .bst file per state; false = .bsz archive
+    serializer state;
+    image preview;
+    uint64_t captureTime = 0;  //in microseconds
+    uint64_t writeTime = 0;    //in microseconds
+    bool result = false;
+
+    auto write() -> bool;
+  };
+  struct StateWriter {
+    ~StateWriter();
+    auto queue(shared_pointer<StateWrite> job) -> void;
+    auto flush() -> void;
+    auto completed() -> vector<shared_pointer<StateWrite>>;
+    auto stop() -> void;
+
+  private:
+    auto worker() -> void;
+
+    std::thread thread;
+    std::mutex lock;
+    std::condition_variable wake;  //signaled when a job is queued or the worker should stop
+    std::condition_variable idle;  //signaled when the worker finishes a job
+    vector<shared_pointer<StateWrite>> pending;
+    vector<shared_pointer<StateWrite>> finished;
+    bool busy = false;
+    bool quit = false;
+  } stateWriter;
 
   //movies.cpp
   struct Movie {
     enum Mode : uint { Inactive, Playing, Recording } mode = Mode::Inactive;
+    static constexpr uint KeyframeInterval = 3600;  //in frames
+    struct Keyframe {
+      uint frame = 0;
+      uint64_t offset = 0;   //file offset of the compressed state (playback)
+      vector<uint8_t> data;  //RLE-compressed state (recording)
+    };
     serializer state;
     vector<int16> input;
+    vector<uint> frames;  //offset into input at the start of each frame; empty for BSV1 movies
+    vector<Keyframe> keyframes;
+    string location;      //movie being played back, to read keyframes from on demand
+    uint position = 0;    //next input to play back
+    uint frame = 0;       //frames begun
+    uint64_t frameCount = ~0ull;  //emulator->frameCount() when the current frame began; ~0 before the first
   } movie;
   auto movieMode(Movie::Mode) -> void;
   auto moviePlay() -> void;
+  auto movieRead(file_buffer& fp, uint8_t version) -> bool;
+  auto movieRestart() -> bool;
   auto movieRecord(bool fromBeginning) -> void;
+  auto movieFrame() -> void;
+  auto movieSeek(uint frame) -> bool;
   auto movieStop() -> void;
 
   //rewind.cpp
   struct Rewind {
     enum Mode : uint { Playing, Rewinding } mode = Mode::Playing;
-    vector<serializer> history;
-    uint length = 0;
+    static constexpr uint KeyframeInterval = 30;  //in entries
+    struct Entry {
+      vector<uint8_t> data;  //RLE(state) for keyframes, RLE(state ^ keyframe) for deltas
+      uint64 sequence = 0;   //monotonic entry number
+      uint distance = 0;     //entries since this entry's keyframe; 0 = keyframe
+      uint size = 0;         //uncompressed state size
+    };
+    vector<Entry> ring;      //power-of-two capacity; grows on demand
+    uint first = 0;          //ring index of the oldest entry
+    uint count = 0;
+    uint64 sequence = 0;     //sequence number of the next entry
+    uint64 bytes = 0;        //compressed bytes held across all entries
+    uint64 budget = 0;       //in bytes
+    vector<uint8_t> keyframe;  //uncompressed keyframe the newest deltas were made against
+    maybe<uint64> keyframeSequence;
     uint frequency = 0;
     uint counter = 0;  //in frames
+
+    //statistics
+    uint lastBytes = 0;
+    uint64 saveTime = 0;  //in microseconds
+    uint64 loadTime = 0;  //in microseconds
   } rewind;
   auto rewindMode(Rewind::Mode) -> void;
   auto rewindReset() -> void;
   auto rewindRun() -> void;
+  auto rewindSave() -> void;
+  auto rewindLoad() -> bool;
+  auto rewindEntry(uint index) -> Rewind::Entry&;
+  auto rewindEvict() -> void;
+  auto rewindStatus() -> string;
 
   //video.cpp
   auto updateVideoDriver(Window parent) -> void;
@@ -97,6 +170,7 @@ struct Program : Lock, Emulator::Platform {
   auto updateVideoShader() -> void;
   auto updateVideoPalette() -> void;
   auto updateVideoEffects() -> void;
+  auto updateVideoFilter() -> void;
   auto toggleVideoFullScreen() -> void;
   auto toggleVideoPseudoFullScreen() -> void;
 
@@ -120,6 +194,7 @@ struct Program : Lock, Emulator::Platform {
   auto selectPath() -> string;
   auto showMessage(string text) -> void;
   auto showFrameRate(string text) -> void;
+  auto profileStatus() -> string;
   auto updateStatus() -> void;
   auto captureScreenshot() -> bool;
   auto inactive() -> bool;
@@ -184,6 +259,14 @@ public:
     vector<uint8_t> program;
   } sufamiTurboA, sufamiTurboB;
 
+  struct Databases {
+    Heuristics::Database superFamicom;
+    Heuristics::Database gameBoy;
+    Heuristics::Database gameBoyColor;
+    Heuristics::Database bsMemory;
+    Heuristics::Database sufamiTurbo;
+  } databases;
+
   vector<string> gameQueue;
 
   uint32_t palette[32768];
@@ -218,6 +301,11 @@ public:
   bool fastForwarding = false;
   bool rewinding = false;
 
+  struct RunAhead {
+    serializer state;  //authoritative state the speculative frames are rolled back to
+    uint generation = 0;
+  } runAhead;
+
   // [jsd] add support for AngelScript
   struct ScriptHostState {
     asIScriptEngine *engine;
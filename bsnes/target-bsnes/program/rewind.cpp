@@ -1,3 +1,8 @@
+//rewind history is a ring of compressed snapshots:
+//every KeyframeInterval entries a full RLE-compressed state (keyframe) is stored;
+//the entries in between store RLE(state ^ keyframe), which is mostly runs of zeroes.
+//the oldest keyframe group is evicted whenever the compressed size exceeds the memory budget.
+
 auto Program::rewindMode(Rewind::Mode mode) -> void {
   rewind.mode = mode;
   rewind.counter = 0;
@@ -5,9 +10,18 @@ auto Program::rewindMode(Rewind::Mode mode) -> void {
 
 auto Program::rewindReset() -> void {
   rewindMode(Rewind::Mode::Playing);
-  rewind.history.reset();
+  rewind.ring.reset();
+  rewind.first = 0;
+  rewind.count = 0;
+  rewind.sequence = 0;
+  rewind.bytes = 0;
+  rewind.keyframe.reset();
+  rewind.keyframeSequence.reset();
+  rewind.lastBytes = 0;
+  rewind.saveTime = 0;
+  rewind.loadTime = 0;
   rewind.frequency = settings.rewind.frequency;
-  rewind.length = settings.rewind.length;
+  rewind.budget = (uint64)settings.rewind.budget << 20;
 }
 
 auto Program::rewindRun() -> void {
@@ -17,26 +31,135 @@ auto Program::rewindRun() -> void {
     if(++rewind.counter < rewind.frequency) return;
 
     rewind.counter = 0;
-    if(rewind.history.size() >= rewind.length) {
-      rewind.history.takeFirst();
-    }
-    auto s = emulator->serialize(0);
-    rewind.history.append(s);
+    rewindSave();
     return;
   }
 
   if(rewind.mode == Rewind::Mode::Rewinding) {
-    if(rewind.history.size() == 0) return rewindMode(Rewind::Mode::Playing);  //nothing left to rewind?
+    if(rewind.count == 0) return rewindMode(Rewind::Mode::Playing);  //nothing left to rewind?
     if(++rewind.counter < rewind.frequency / 4) return;
 
     rewind.counter = 0;
-    auto t = rewind.history.takeLast();
-    serializer s{t.data(), t.size()};  //convert serializer::Save to serializer::Load
-    if(!rewind.history) {
+    if(!rewindLoad() || !rewind.count) {
       showMessage("Rewind history exhausted");
       rewindReset();
     }
-    emulator->unserialize(s);
     return;
   }
 }
+
+auto Program::rewindEntry(uint index) -> Rewind::Entry& {
+  return rewind.ring[rewind.first + index & rewind.ring.size() - 1];
+}
+
+auto Program::rewindSave() -> void {
+  auto timeStart = chrono::microsecond();
+  auto state = emulator->serialize(0);
+
+  //grow the ring by doubling its capacity, keeping entries in order:
+  if(rewind.count == rewind.ring.size()) {
+    vector<Rewind::Entry> ring;
+    ring.resize(max(16u, rewind.ring.size() * 2));
+    for(uint index : range(rewind.count)) ring[index] = move(rewindEntry(index));
+    rewind.ring = move(ring);
+    rewind.first = 0;
+  }
+
+  Rewind::Entry entry;
+  entry.sequence = rewind.sequence++;
+  entry.size = state.size();
+
+  //deltas are only valid against the keyframe of the newest entry's group:
+  bool delta = false;
+  if(rewind.count && rewind.keyframeSequence) {
+    auto& last = rewindEntry(rewind.count - 1);
+    delta = last.sequence - last.distance == rewind.keyframeSequence()
+         && last.distance + 1 < Rewind::KeyframeInterval
+         && rewind.keyframe.size() == state.size();
+    if(delta) entry.distance = last.distance + 1;
+  }
+
+  if(delta) {
+    vector<uint8_t> difference;
+    difference.resize(state.size());
+    auto source = state.data();
+    auto base = rewind.keyframe.data();
+    for(uint offset : range(state.size())) difference[offset] = source[offset] ^ base[offset];
+    entry.data = Encode::RLE<1>(difference);
+  } else {
+    rewind.keyframe.resize(state.size());
+    memory::copy(rewind.keyframe.data(), state.data(), state.size());
+    rewind.keyframeSequence = entry.sequence;
+    entry.data = Encode::RLE<1>({state.data(), state.size()});
+  }
+
+  rewind.lastBytes = entry.data.size();
+  rewind.bytes += entry.data.size();
+  rewindEntry(rewind.count++) = move(entry);
+  rewindEvict();
+
+  rewind.saveTime = chrono::microsecond() - timeStart;
+}
+
+//drops whole keyframe groups from the front of the ring until the history fits the budget.
+//the newest group is always kept, so at least one state survives even with a tiny budget.
+auto Program::rewindEvict() -> void {
+  while(rewind.bytes > rewind.budget && rewind.count) {
+    uint groupSize = 1;
+    while(groupSize < rewind.count && rewindEntry(groupSize).distance) groupSize++;
+    if(groupSize == rewind.count) break;
+
+    for(uint index : range(groupSize)) {
+      auto& entry = rewindEntry(0);
+      rewind.bytes -= entry.data.size();
+      entry.data.reset();
+      rewind.first = rewind.first + 1 & rewind.ring.size() - 1;
+      rewind.count--;
+    }
+  }
+}
+
+auto Program::rewindLoad() -> bool {
+  if(!rewind.count) return false;
+  auto timeStart = chrono::microsecond();
+
+  auto entry = move(rewindEntry(rewind.count - 1));
+  rewind.bytes -= entry.data.size();
+  rewind.count--;
+  rewind.sequence = entry.sequence;  //keeps sequence - distance valid for entries saved after resuming
+
+  auto keyframeSequence = entry.sequence - entry.distance;
+  if(entry.distance && (!rewind.keyframeSequence || rewind.keyframeSequence() != keyframeSequence)) {
+    //the cached keyframe belongs to a newer group; decode this entry's keyframe:
+    auto& keyframe = rewindEntry(rewind.count - entry.distance);
+    if(keyframe.sequence != keyframeSequence) return false;  //should never occur
+    rewind.keyframe = Decode::RLE<1>(keyframe.data);
+    rewind.keyframeSequence = keyframeSequence;
+  }
+
+  auto state = Decode::RLE<1>(entry.data);
+  if(state.size() != entry.size) return false;
+  if(entry.distance) {
+    if(rewind.keyframe.size() != state.size()) return false;
+    auto base = rewind.keyframe.data();
+    for(uint offset : range(state.size())) state[offset] ^= base[offset];
+  } else {
+    //a keyframe is consumed; the next entry down belongs to the previous group:
+    rewind.keyframe.reset();
+    rewind.keyframeSequence.reset();
+  }
+
+  serializer s{state.data(), (uint)state.size()};
+  bool result = emulator->unserialize(s);
+  rewind.loadTime = chrono::microsecond() - timeStart;
+  return result;
+}
+
+auto Program::rewindStatus() -> string {
+  if(!rewind.count) return {};
+  return {
+    rewind.count, " states, ",
+    rewind.bytes / 1024, " KB (", rewind.bytes / rewind.count / 1024, " KB/state, last ", rewind.lastBytes / 1024, " KB), ",
+    "save ", rewind.saveTime, " us, load ", rewind.loadTime, " us"
+  };
+}
@@ -3,6 +3,7 @@ const uint Program::State::Signature = 0x5a22'0000;
 auto Program::availableStates(string type) -> vector<State> {
   vector<State> result;
   if(!emulator->loaded()) return result;
+  stateWriter.flush();
 
   if(gamePath().endsWith("/")) {
     for(auto& file : directory::ifiles({statePath(), type}, "*.bst")) {
@@ -24,6 +25,7 @@ auto Program::availableStates(string type) -> vector<State> {
 
 auto Program::hasState(string filename) -> bool {
   if(!emulator->loaded()) return false;
+  stateWriter.flush();
 
   if(gamePath().endsWith("/")) {
     return file::exists({statePath(), filename, ".bst"});
@@ -35,6 +37,7 @@ auto Program::hasState(string filename) -> bool {
 
 auto Program::loadStateData(string filename) -> vector<uint8_t> {
   if(!emulator->loaded()) return {};
+  stateWriter.flush();
 
   vector<uint8_t> memory;
   if(gamePath().endsWith("/")) {
@@ -59,33 +62,76 @@ auto Program::loadStateData(string filename) -> vector<uint8_t> {
 
 auto Program::loadState(string filename) -> bool {
   string prefix = Location::file(filename);
+  auto timeStart = chrono::microsecond();
   if(auto memory = loadStateData(filename)) {
     if(filename != "Quick/Undo") saveUndoState();
     if(filename == "Quick/Undo") saveRedoState();
+    auto timeRead = chrono::microsecond();
     auto serializerRLE = Decode::RLE<1>({memory.data() + 3 * sizeof(uint), memory.size() - 3 * sizeof(uint)});
     serializer s{serializerRLE.data(), (uint)serializerRLE.size()};
     if(!emulator->unserialize(s)) return showMessage({"[", prefix, "] is in incompatible format"}), false;
     rewindReset();  //do not allow rewinding past a state load event
-    return showMessage({"Loaded [", prefix, "]"}), true;
+    //read covers waiting for pending writes and reading the file; restore covers decompression and unserialize
+    auto readTime = timeRead - timeStart;
+    auto restoreTime = chrono::microsecond() - timeRead;
+    return showMessage({"Loaded [", prefix, "] (read ", readTime, " us, restore ", restoreTime, " us)"}), true;
   } else {
     return showMessage({"[", prefix, "] not found"}), false;
   }
 }
 
-auto Program::saveState(string filename) -> bool {
+//the state is written in the background: without wait, true only means the state was captured and queued, and a
+//failed write is reported when it completes. with wait, the result is that of the write itself.
+auto Program::saveState(string filename, bool wait) -> bool {
   if(!emulator->loaded()) return false;
   string prefix = Location::file(filename);
+  auto timeStart = chrono::microsecond();
 
-  serializer s = emulator->serialize();
-  if(!s.size()) return showMessage({"Failed to save [", prefix, "]"}), false;
-  auto serializerRLE = Encode::RLE<1>({s.data(), s.size()});
+  //only capture the state here; compression and disk I/O happen on the state writer thread
+  shared_pointer<StateWrite> job{new StateWrite};
+  job->state = emulator->serialize();
+  if(!job->state.size()) return showMessage({"Failed to save [", prefix, "]"}), false;
 
-  vector<uint8_t> previewRLE;
   //this can be null if a state is captured before the first frame of video output after power/reset
   if(screenshot.data) {
-    image preview;
-    preview.transform(0, 15, 0x8000, 0x7c00, 0x03e0, 0x001f);
-    preview.copy(screenshot.data, screenshot.pitch, screenshot.width, screenshot.height);
+    job->preview.transform(0, 15, 0x8000, 0x7c00, 0x03e0, 0x001f);
+    job->preview.copy(screenshot.data, screenshot.pitch, screenshot.width, screenshot.height);
+  }
+
+  job->filename = filename;
+  job->statePath = statePath();
+  job->folder = gamePath().endsWith("/");
+  job->captureTime = chrono::microsecond() - timeStart;
+  stateWriter.queue(job);
+  if(!wait) return true;
+
+  stateWriter.flush();
+  writeStates();
+  return job->result;
+}
+
+//reports state writes completed by the worker thread; called from the main thread
+auto Program::writeStates() -> void {
+  for(auto& job : stateWriter.completed()) {
+    string prefix = Location::file(job->filename);
+    if(!job->result) {
+      showMessage({"Unable to write [", prefix, "] to disk"});
+      continue;
+    }
+    if(job->filename.beginsWith("Quick/")) presentation.updateStateMenus();
+    stateManager.stateEvent(job->filename);
+    if(job->filename == "Quick/Undo" || job->filename == "Quick/Redo") continue;
+    showMessage({"Saved [", prefix, "] (capture ", job->captureTime, " us, write ", job->writeTime, " us)"});
+  }
+}
+
+//runs on the state writer thread: must not touch the emulator or any hiro objects
+auto Program::StateWrite::write() -> bool {
+  auto timeStart = chrono::microsecond();
+  auto serializerRLE = Encode::RLE<1>({state.data(), state.size()});
+
+  vector<uint8_t> previewRLE;
+  if(preview) {
     if(preview.width() != 256 || preview.height() != 240) preview.scale(256, 240, true);
     previewRLE = Encode::RLE<2>({preview.data(), preview.size()});
   }
@@ -98,20 +144,23 @@ auto Program::saveState(string filename) -> bool {
   saveState.append(serializerRLE);
   saveState.append(previewRLE);
 
-  if(gamePath().endsWith("/")) {
-    string location = {statePath(), filename, ".bst"};
+  //write to a temporary file first and rename it over the original,
+  //so that an interrupted write never leaves a truncated state or archive behind
+  if(folder) {
+    string location = {statePath, filename, ".bst"};
+    string temporary = {location, ".tmp"};
     directory::create(Location::path(location));
-    if(!file::write(location, saveState)) {
-      return showMessage({"Unable to write [", prefix, "] to disk"}), false;
-    }
+    if(!file::write(temporary, saveState)) return false;
+    if(!file::move(temporary, location)) return file::remove(temporary), false;
   } else {
     string location = {filename, ".bst"};
+    string temporary = {statePath, ".tmp"};
 
     struct State { string name; time_t timestamp; vector<uint8_t> memory; };
     vector<State> states;
 
     Decode::ZIP input;
-    if(input.open(statePath())) {
+    if(input.open(statePath)) {
       for(auto& file : input.file) {
         if(!file.name.endsWith(".bst")) continue;
         if(file.name == location) continue;
@@ -120,22 +169,76 @@ auto Program::saveState(string filename) -> bool {
     }
     input.close();
 
-    Encode::ZIP output{statePath()};
-    for(auto& state : states) {
-      output.append(state.name, state.memory.data(), state.memory.size(), state.timestamp);
+    {
+      Encode::ZIP output{temporary};
+      for(auto& state : states) {
+        output.append(state.name, state.memory.data(), state.memory.size(), state.timestamp);
+      }
+      output.append(location, saveState.data(), saveState.size());
     }
-    output.append(location, saveState.data(), saveState.size());
+    if(!file::move(temporary, statePath)) return file::remove(temporary), false;
+  }
+
+  writeTime = chrono::microsecond() - timeStart;
+  return true;
+}
+
+Program::StateWriter::~StateWriter() {
+  stop();
+}
+
+auto Program::StateWriter::queue(shared_pointer<StateWrite> job) -> void {
+  std::lock_guard<std::mutex> guard(lock);
+  if(!thread.joinable()) {
+    quit = false;
+    thread = std::thread([this] { worker(); });
   }
+  pending.append(job);
+  wake.notify_one();
+}
+
+//blocks until every queued state has been written, so that reads see a consistent view of the state files
+auto Program::StateWriter::flush() -> void {
+  std::unique_lock<std::mutex> guard(lock);
+  idle.wait(guard, [this] { return !pending && !busy; });
+}
+
+auto Program::StateWriter::completed() -> vector<shared_pointer<StateWrite>> {
+  std::lock_guard<std::mutex> guard(lock);
+  return move(finished);
+}
 
-  if(filename.beginsWith("Quick/")) presentation.updateStateMenus();
-  stateManager.stateEvent(filename);
-  return showMessage({"Saved [", prefix, "]"}), true;
+auto Program::StateWriter::stop() -> void {
+  flush();
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    quit = true;
+    wake.notify_all();
+  }
+  if(thread.joinable()) thread.join();
+}
+
+auto Program::StateWriter::worker() -> void {
+  std::unique_lock<std::mutex> guard(lock);
+  while(true) {
+    wake.wait(guard, [this] { return pending || quit; });
+    if(!pending) return;
+
+    auto job = pending.takeFirst();
+    busy = true;
+    guard.unlock();
+    job->result = job->write();
+    guard.lock();
+    busy = false;
+    finished.append(job);
+    idle.notify_all();
+  }
 }
 
-auto Program::saveUndoState() -> bool {
+auto Program::saveUndoState(bool wait) -> bool {
   auto statusTime = this->statusTime;
   auto statusMessage = this->statusMessage;
-  auto result = saveState("Quick/Undo");
+  auto result = saveState("Quick/Undo", wait);
   this->statusTime = statusTime;
   this->statusMessage = statusMessage;
   return result;
@@ -152,6 +255,7 @@ auto Program::saveRedoState() -> bool {
 
 auto Program::removeState(string filename) -> bool {
   if(!emulator->loaded()) return false;
+  stateWriter.flush();
   bool result = false;
 
   if(gamePath().endsWith("/")) {
@@ -195,6 +299,7 @@ auto Program::removeState(string filename) -> bool {
 
 auto Program::renameState(string from_, string to_) -> bool {
   if(!emulator->loaded()) return false;
+  stateWriter.flush();
   bool result = false;
 
   if(gamePath().endsWith("/")) {
@@ -58,6 +58,17 @@ auto Program::showFrameRate(string text) -> void {
   statusFrameRate = text;
 }
 
+//host milliseconds per component over the last frame, shown after the frame rate while profiling
+auto Program::profileStatus() -> string {
+  string status;
+  for(auto& entry : emulator->profile()) {
+    if(entry.nanoseconds < 100'000) continue;
+    status.append(" ", entry.name, " ", entry.nanoseconds / 1'000'000, ".", entry.nanoseconds / 100'000 % 10);
+  }
+  if(status) status.append(" ms");
+  return status;
+}
+
 auto Program::updateStatus() -> void {
   string message;
   if(chrono::millisecond() - statusTime <= 2000) {
@@ -76,6 +87,8 @@ auto Program::updateStatus() -> void {
     frameRate = tr("Paused");
   } else if(!focused() && inputSettings.pauseEmulation.checked()) {
     frameRate = tr("Paused");
+  } else if(rewinding && rewind.count) {
+    frameRate = rewindStatus();
   } else {
     frameRate = statusFrameRate;
   }
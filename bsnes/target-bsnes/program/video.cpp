@@ -152,3 +152,7 @@ auto Program::toggleVideoPseudoFullScreen() -> void {
     presentation.setFullScreen(false);
   }
 }
+
+auto Program::updateVideoFilter() -> void {
+  Filter::setThreads(settings.video.filterThreads);
+}
@@ -176,7 +176,7 @@ auto DriverSettings::videoDriverChange() -> void {
     "Do you wish to proceed with the video driver change now anyway?"
   ).setAlignment(*settingsWindow).question() == "Yes") {
     program.save();
-    program.saveUndoState();
+    program.saveUndoState(true);  //on disk before a driver change that may crash
     settings.general.crashed = true;
     settings.save();
     program.updateVideoDriver(settingsWindow);
@@ -251,7 +251,7 @@ auto DriverSettings::audioDriverChange() -> void {
     "Do you wish to proceed with the audio driver change now anyway?"
   ).setAlignment(*settingsWindow).question() == "Yes") {
     program.save();
-    program.saveUndoState();
+    program.saveUndoState(true);
     settings.general.crashed = true;
     settings.save();
     program.updateAudioDriver(settingsWindow);
@@ -337,7 +337,7 @@ auto DriverSettings::inputDriverChange() -> void {
     "Do you wish to proceed with the input driver change now anyway?"
   ).setAlignment(*settingsWindow).question() == "Yes") {
     program.save();
-    program.saveUndoState();
+    program.saveUndoState(true);
     settings.general.crashed = true;
     settings.save();
     program.updateInputDriver(settingsWindow);
@@ -107,21 +107,21 @@ auto EmulatorSettings::create() -> void {
     program.rewindReset();
   });
 
-  rewindLengthLabel.setText("Length:");
-  rewindLengthOption.append(ComboButtonItem().setText( "10 states"));
-  rewindLengthOption.append(ComboButtonItem().setText( "20 states"));
-  rewindLengthOption.append(ComboButtonItem().setText( "40 states"));
-  rewindLengthOption.append(ComboButtonItem().setText( "80 states"));
-  rewindLengthOption.append(ComboButtonItem().setText("160 states"));
-  rewindLengthOption.append(ComboButtonItem().setText("320 states"));
-  if(settings.rewind.length ==  10) rewindLengthOption.item(0).setSelected();
-  if(settings.rewind.length ==  20) rewindLengthOption.item(1).setSelected();
-  if(settings.rewind.length ==  40) rewindLengthOption.item(2).setSelected();
-  if(settings.rewind.length ==  80) rewindLengthOption.item(3).setSelected();
-  if(settings.rewind.length == 160) rewindLengthOption.item(4).setSelected();
-  if(settings.rewind.length == 320) rewindLengthOption.item(5).setSelected();
-  rewindLengthOption.onChange([&] {
-    settings.rewind.length = 10 << rewindLengthOption.selected().offset();
+  rewindBudgetLabel.setText("Memory:");
+  rewindBudgetOption.append(ComboButtonItem().setText( "16 MB"));
+  rewindBudgetOption.append(ComboButtonItem().setText( "32 MB"));
+  rewindBudgetOption.append(ComboButtonItem().setText( "64 MB"));
+  rewindBudgetOption.append(ComboButtonItem().setText("128 MB"));
+  rewindBudgetOption.append(ComboButtonItem().setText("256 MB"));
+  rewindBudgetOption.append(ComboButtonItem().setText("512 MB"));
+  if(settings.rewind.budget ==  16) rewindBudgetOption.item(0).setSelected();
+  if(settings.rewind.budget ==  32) rewindBudgetOption.item(1).setSelected();
+  if(settings.rewind.budget ==  64) rewindBudgetOption.item(2).setSelected();
+  if(settings.rewind.budget == 128) rewindBudgetOption.item(3).setSelected();
+  if(settings.rewind.budget == 256) rewindBudgetOption.item(4).setSelected();
+  if(settings.rewind.budget == 512) rewindBudgetOption.item(5).setSelected();
+  rewindBudgetOption.onChange([&] {
+    settings.rewind.budget = 16 << rewindBudgetOption.selected().offset();
     program.rewindReset();
   });
 
@@ -67,6 +67,7 @@ auto Settings::process(bool load) -> void {
   bind(boolean, "Video/Overscan",         video.overscan);
   bind(boolean, "Video/Blur",             video.blur);
   bind(text,    "Video/Filter",           video.filter);
+  bind(natural, "Video/FilterThreads",    video.filterThreads);
 
   bind(text,    "Audio/Driver",    audio.driver);
   bind(boolean, "Audio/Exclusive", audio.exclusive);
@@ -107,7 +108,7 @@ auto Settings::process(bool load) -> void {
   bind(boolean, "FastForward/Mute",      fastForward.mute);
 
   bind(natural, "Rewind/Frequency", rewind.frequency);
-  bind(natural, "Rewind/Length",    rewind.length);
+  bind(natural, "Rewind/Budget",    rewind.budget);
   bind(boolean, "Rewind/Mute",      rewind.mute);
 
   bind(boolean, "Emulator/WarnOnUnverifiedGames",        emulator.warnOnUnverifiedGames);
@@ -147,6 +148,10 @@ auto Settings::process(bool load) -> void {
 
   bind(text,    "Script/AutoLoadLocation",  script.autoLoadLocation);
 
+  bind(boolean, "Network/Usb2snes/Enable", network.usb2snes.enable);
+  bind(text,    "Network/Usb2snes/Host",   network.usb2snes.host);
+  bind(natural, "Network/Usb2snes/Port",   network.usb2snes.port);
+
   #undef bind
 }
 
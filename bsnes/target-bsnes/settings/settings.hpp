@@ -28,6 +28,7 @@ struct Settings : Markup::Node {
     bool overscan = false;
     bool blur = false;
     string filter = "None";
+    uint filterThreads = min(3u, std::thread::hardware_concurrency() / 2);
   } video;
 
   struct Audio {
@@ -84,7 +85,7 @@ struct Settings : Markup::Node {
 
   struct Rewind {
     uint frequency = 0;
-    uint length = 80;
+    uint budget = 64;  //in megabytes
     bool mute = false;
   } rewind;
 
@@ -154,6 +155,14 @@ struct Settings : Markup::Node {
   struct Script {
     string autoLoadLocation;
   } script;
+
+  struct Network {
+    struct Usb2snes {
+      bool enable = false;
+      string host = "127.0.0.1";
+      uint port = 23074;
+    } usb2snes;
+  } network;
 };
 
 struct VideoSettings : VerticalLayout {
@@ -336,8 +345,8 @@ public:
   HorizontalLayout rewindLayout{this, Size{~0, 0}};
     Label rewindFrequencyLabel{&rewindLayout, Size{0, 0}};
     ComboButton rewindFrequencyOption{&rewindLayout, Size{0, 0}};
-    Label rewindLengthLabel{&rewindLayout, Size{0, 0}};
-    ComboButton rewindLengthOption{&rewindLayout, Size{0, 0}};
+    Label rewindBudgetLabel{&rewindLayout, Size{0, 0}};
+    ComboButton rewindBudgetOption{&rewindLayout, Size{0, 0}};
   CheckLabel rewindMute{this, Size{0, 0}};
 };
 
@@ -20,10 +20,10 @@ auto CheatDatabase::findCheats() -> void {
   auto sha256a = emulator->hashes()(0, "none");
   auto sha256b = emulator->hashes()(1, "none");
 
-  auto document = BML::unserialize(string::read(locate("Database/Cheat Codes.bml")));
-  for(auto game : document.find("cartridge")) {
-    if(game["sha256"].text() != sha256a
-    && game["sha256"].text() != sha256b) continue;
+  if(!database.open(locate("Database/Cheat Codes.bml"))) return;
+  for(auto& sha256 : {sha256a, sha256b}) {
+    auto game = database.find(sha256);
+    if(game.name() != "cartridge") continue;
 
     cheatList.reset();
     for(auto cheat : game.find("cheat")) {
@@ -49,6 +49,7 @@ struct CheatDatabase : Window {
   auto addCheats() -> void;
 
 public:
+  Heuristics::Database database;
   VerticalLayout layout{this};
     ListView cheatList{&layout, Size{~0, ~0}};
     HorizontalLayout controlLayout{&layout, Size{~0, 0}};
@@ -0,0 +1,104 @@
+//renders the last frame through each video filter, with every instruction set the filters have kernels for,
+//on the calling thread alone and with worker threads. the rate is in output megapixels per second.
+//every output is compared against the scalar single-threaded one; returns false if any differs.
+static auto benchmarkFilters(const Program::Frame& frame) -> bool {
+  struct Entry {
+    string name;
+    Filter::Size size;
+    Filter::Render render;
+  };
+  const Entry filters[] = {
+    {"None",            &Filter::None::size,           &Filter::None::render},
+    {"Scanlines Light", &Filter::ScanlinesLight::size, &Filter::ScanlinesLight::render},
+    {"Scanlines Dark",  &Filter::ScanlinesDark::size,  &Filter::ScanlinesDark::render},
+    {"Scanlines Black", &Filter::ScanlinesBlack::size, &Filter::ScanlinesBlack::render},
+    {"Pixellate2x",     &Filter::Pixellate2x::size,    &Filter::Pixellate2x::render},
+    {"Scale2x",         &Filter::Scale2x::size,        &Filter::Scale2x::render},
+    {"LQ2x",            &Filter::LQ2x::size,           &Filter::LQ2x::render},
+    {"HQ2x",            &Filter::HQ2x::size,           &Filter::HQ2x::render},
+    {"NTSC (RF)",       &Filter::NTSC_RF::size,        &Filter::NTSC_RF::render},
+    {"NTSC (RGB)",      &Filter::NTSC_RGB::size,       &Filter::NTSC_RGB::render},
+  };
+
+  //the 2x filters accept up to 256x240, so high resolution frames are sampled down to that
+  uint xstep = frame.width  > 256 ? 2 : 1;
+  uint ystep = frame.height > 240 ? 2 : 1;
+  uint width  = frame.width  / xstep;
+  uint height = frame.height / ystep;
+  vector<uint16_t> input;
+  input.resize(width * height);
+  for(uint y : range(height)) {
+    for(uint x : range(width)) input[y * width + x] = frame.pixels[y * ystep * frame.width + x * xstep] & 0x7fff;
+  }
+
+  vector<uint32_t> palette;
+  palette.resize(32768);
+  for(uint color : range(32768)) {
+    uint r = color >>  0 & 31;
+    uint g = color >>  5 & 31;
+    uint b = color >> 10 & 31;
+    palette[color] = 255u << 24 | (r << 3 | r >> 2) << 16 | (g << 3 | g >> 2) << 8 | (b << 3 | b >> 2) << 0;
+  }
+
+  //workers are tried even on a single core, so that the banding is still checked against the reference
+  vector<uint> threads{0, max(1u, min(3u, std::thread::hardware_concurrency() - 1))};
+
+  bool identical = true;
+  print("filter           isa     threads  output     Mpx/s\n");
+  for(auto& filter : filters) {
+    uint outputWidth = width, outputHeight = height;
+    filter.size(outputWidth, outputHeight);
+    //some filters (eg NTSC (RF)) alternate between two outputs from frame to frame, so either is a match
+    vector<uint32_t> references[2], output;
+    for(auto& reference : references) reference.resize(outputWidth * outputHeight);
+    output.resize(outputWidth * outputHeight);
+
+    for(auto set : Filter::instructionSets()) {
+      Filter::setInstructionSet(set);
+      for(auto count : threads) {
+        Filter::setThreads(count);
+        auto render = [&](uint32_t* target) {
+          filter.render(palette.data(), target, outputWidth * sizeof(uint32_t),
+            input.data(), width * sizeof(uint16_t), width, height);
+        };
+
+        //the first render builds the lookup tables of the filter, so it is not timed
+        string result;
+        if(set == Filter::InstructionSet::Scalar && count == 0) {
+          for(auto& reference : references) render(reference.data());
+        } else {
+          render(output.data());
+          bool matched = false;
+          for(auto& reference : references) {
+            matched |= !memory::compare(reference.data(), output.data(), output.size() * sizeof(uint32_t));
+          }
+          if(!matched) {
+            result = " (differs from scalar)";
+            identical = false;
+          }
+        }
+
+        //the fastest of several runs is reported, as it is the one least disturbed by the rest of the system
+        double rate = 0;
+        for(uint run : range(8)) {
+          uint iterations = 0;
+          auto start = chrono::nanosecond();
+          uint64 elapsed = 0;
+          do {
+            render(output.data());
+            iterations++;
+            elapsed = chrono::nanosecond() - start;
+          } while(elapsed < 25'000'000);
+          rate = max(rate, outputWidth * outputHeight * iterations * 1000.0 / elapsed);
+        }
+
+        print(pad(filter.name, -16), " ", pad(Filter::name(set), -7), " ", pad(count, 7), "  ",
+          pad(string{outputWidth, "x", outputHeight}, -9), " ",
+          pad((uint64)rate, 7), result, "\n");
+      }
+    }
+  }
+
+  Filter::setThreads(0);
+  return identical;
+}
@@ -0,0 +1,306 @@
+#include "program.cpp"
+#include "benchmark.cpp"
+
+static auto usage() -> void {
+  print(
+    "usage: bsnes-headless [options] game.sfc\n"
+    "  --frames=N        number of frames to emulate (default 600)\n"
+    "  --script=PATH     AngelScript file or folder to load\n"
+    "  --movie=PATH      play back the input of a BSV1/BSV2 movie\n"
+    "  --video=PATH      dump every frame (16-bit width, 16-bit height, BGR555 pixels)\n"
+    "  --audio=PATH      dump audio as a 16-bit stereo WAV file\n"
+    "  --per-frame       print the timing of every frame (frame, host us, script us)\n"
+    "  --accurate        use the cycle-based PPU and DSP instead of the fast ones\n"
+    "  --profile         report the host time, emulated clocks and thread switches of each component\n"
+    "  --filters         benchmark the video filters on the last frame, per instruction set and thread count\n"
+    "  --states          check after every frame that an incremental save state matches a full one\n"
+    "  --database=PATH   use the manifest of Super Famicom.bml when the game is listed in it\n"
+    "  --configure=K=V   set an emulator option, e.g. --configure=Hacks/CPU/Overclock=150\n"
+    "                    (Hacks/Entropy defaults to None, so that runs are reproducible)\n"
+    "  --netplay=PEER    play controller 1 against a remote player with rollback netplay, where PEER is\n"
+    "                    udp:LOCALPORT:HOST:PORT, or loopback[:LATENCY[:LOSS]] for a simulated player that\n"
+    "                    answers LATENCY frames late (default 4) and drops LOSS percent of its packets\n"
+    "  --player=N        play controller N (1 or 2) in netplay instead. both players play the loopback's\n"
+    "                    pseudo-random input, so that two instances exercise rollbacks over UDP\n"
+    "  --delay=N         frames of netplay input delay (default 2)\n"
+    "  --rollback=N      most frames netplay may roll back (default 8)\n"
+    "the exit status is 1 if the game failed to load, a script reported an error or a check failed\n"
+  );
+}
+
+//sorted must be non-empty:
+static auto percentile(const vector<uint64>& sorted, uint percent) -> uint64 {
+  return sorted[min(sorted.size() - 1, sorted.size() * percent / 100)];
+}
+
+#include <nall/main.hpp>
+auto nall::main(Arguments arguments) -> void {
+  uint frames = 600;
+  string scriptLocation;
+  string movieLocation;
+  string videoLocation;
+  string audioLocation;
+  string gameLocation;
+  string databaseLocation;
+  bool perFrame = false;
+  bool accurate = false;
+  bool profile = false;
+  bool filters = false;
+  bool states = false;
+  vector<string> configuration;
+  string netplayPeer;
+  Emulator::Netplay::Settings netplaySettings;
+  bool netplayOnline = false;  //a real peer, which is waited on instead of spun on
+
+  for(auto argument : arguments) {
+    if(argument.beginsWith("--frames=")) {
+      frames = argument.trimLeft("--frames=", 1L).natural();
+    } else if(argument.beginsWith("--script=")) {
+      scriptLocation = argument.trimLeft("--script=", 1L);
+    } else if(argument.beginsWith("--movie=")) {
+      movieLocation = argument.trimLeft("--movie=", 1L);
+    } else if(argument.beginsWith("--video=")) {
+      videoLocation = argument.trimLeft("--video=", 1L);
+    } else if(argument.beginsWith("--audio=")) {
+      audioLocation = argument.trimLeft("--audio=", 1L);
+    } else if(argument.beginsWith("--database=")) {
+      databaseLocation = argument.trimLeft("--database=", 1L);
+    } else if(argument.beginsWith("--configure=")) {
+      configuration.append(argument.trimLeft("--configure=", 1L));
+    } else if(argument.beginsWith("--netplay=")) {
+      netplayPeer = argument.trimLeft("--netplay=", 1L);
+    } else if(argument.beginsWith("--player=")) {
+      netplaySettings.player = argument.trimLeft("--player=", 1L).natural() - 1;
+    } else if(argument.beginsWith("--delay=")) {
+      netplaySettings.delay = argument.trimLeft("--delay=", 1L).natural();
+    } else if(argument.beginsWith("--rollback=")) {
+      netplaySettings.window = argument.trimLeft("--rollback=", 1L).natural();
+    } else if(argument == "--per-frame") {
+      perFrame = true;
+    } else if(argument == "--accurate") {
+      accurate = true;
+    } else if(argument == "--profile") {
+      profile = true;
+    } else if(argument == "--filters") {
+      filters = true;
+    } else if(argument == "--states") {
+      states = true;
+    } else if(argument == "--help" || argument.beginsWith("--")) {
+      return usage();
+    } else {
+      gameLocation = argument;
+    }
+  }
+  if(!gameLocation) return usage();
+
+  emulator = new SuperFamicom::Interface;
+  program = new Program;
+  Emulator::audio.setFrequency(48000);
+
+  //runs are compared by their output hashes, so memory starts out the same every time unless overridden
+  emulator->configure("Hacks/Entropy", "None");
+
+  if(accurate) {
+    emulator->configure("Hacks/PPU/Fast", false);
+    emulator->configure("Hacks/DSP/Fast", false);
+  }
+  for(auto& option : configuration) {
+    auto part = option.split("=", 1L);
+    if(part.size() != 2 || !emulator->configure(part[0], part[1])) {
+      print(stderr, "unknown option: ", option, "\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  program->scriptInit();
+  program->frame.keep = filters;
+  program->databaseLocation = databaseLocation;
+
+  if(!program->loadSuperFamicom(gameLocation) || !emulator->load()) {
+    print(stderr, "failed to load game: ", gameLocation, "\n");
+    exit(EXIT_FAILURE);
+  }
+  emulator->connect(SuperFamicom::ID::Port::Controller1, SuperFamicom::ID::Device::Gamepad);
+  emulator->connect(SuperFamicom::ID::Port::Controller2, SuperFamicom::ID::Device::Gamepad);
+  emulator->power();
+  print("game: ", program->superFamicom.title, " (", program->superFamicom.region, ")",
+    program->superFamicom.verified ? ", verified" : "", "\n");
+
+  if(movieLocation) {
+    if(!program->loadMovie(movieLocation)) {
+      print(stderr, "failed to load movie: ", movieLocation, "\n");
+      exit(EXIT_FAILURE);
+    }
+    if(program->movie.state.capacity()) {
+      serializer s{program->movie.state.data(), program->movie.state.capacity()};
+      if(!emulator->unserialize(s)) {
+        print(stderr, "movie state is in an incompatible format\n");
+        exit(EXIT_FAILURE);
+      }
+    } else {
+      //entropy can desync movies recorded without save states
+      emulator->configure("Hacks/Entropy", "None");
+      emulator->power();
+    }
+  }
+
+  if(videoLocation && !program->openVideo(videoLocation)) {
+    print(stderr, "failed to open video output: ", videoLocation, "\n");
+    exit(EXIT_FAILURE);
+  }
+  if(audioLocation && !program->openAudio(audioLocation)) {
+    print(stderr, "failed to open audio output: ", audioLocation, "\n");
+    exit(EXIT_FAILURE);
+  }
+
+  if(netplayPeer) {
+    auto part = netplayPeer.split(":");
+    shared_pointer<Emulator::Netplay::Peer> peer;
+    if(part[0] == "loopback" && part.size() <= 3) {
+      uint latency = part.size() >= 2 ? part[1].natural() : 4;
+      uint loss = part.size() >= 3 ? part[2].natural() : 0;
+      peer = new Emulator::Netplay::Loopback(latency, loss, netplaySettings.delay, netplaySettings.window);
+    } else if(part[0] == "udp" && part.size() == 4) {
+      auto udp = new Emulator::Netplay::UDP;
+      peer = udp;
+      netplayOnline = true;
+      if(!udp->open(part[1].natural(), part[2], part[3].natural())) peer.reset();
+    }
+    if(!peer || !program->netplay.start(emulator, peer, netplaySettings)) {
+      print(stderr, "failed to start netplay: ", netplayPeer, "\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  //the script is loaded last, so that cartridge_loaded() and post_power() see the final state
+  if(scriptLocation) program->scriptLoad(scriptLocation);
+
+  vector<uint64> times;
+  vector<uint64> scriptTimes;
+  times.reserve(frames);
+  scriptTimes.reserve(frames);
+  if(perFrame) print("frame,us,script_us\n");
+
+  //totals per component, in the order components first appear
+  vector<Emulator::Interface::Profile> profiles;
+  if(profile) emulator->setProfiling(true);
+
+  //one state is brought up to date every frame, which copies only the pages written since the previous frame
+  serializer state;
+  uint stateGeneration = 0;
+  uint stateMismatches = 0;
+  maybe<uint> firstMismatch;
+
+  auto start = chrono::nanosecond();
+  for(uint frame : range(frames)) {
+    program->script.time = 0;
+    auto frameStart = chrono::nanosecond();
+    if(program->netplay) {
+      //frames that are rolled back and run again are included in the time of the frame that caught up:
+      while(!program->netplay.run(Emulator::Netplay::Loopback::input(frame))) {
+        if(chrono::nanosecond() - frameStart > 10'000'000'000ull) {
+          print(stderr, "netplay: the remote player stopped answering at frame ", frame, "\n");
+          exit(EXIT_FAILURE);
+        }
+        if(netplayOnline) usleep(1000);
+      }
+    } else {
+      //run() returns at every scheduler event; a frame is complete once it has been output:
+      for(auto output = program->output.frames; program->output.frames == output;) emulator->run();
+    }
+    auto time = chrono::nanosecond() - frameStart;
+    if(states) {
+      auto full = emulator->serialize(false);
+      if(!emulator->serialize(state, stateGeneration) || full.size() != state.size()
+      || memory::compare(full.data(), state.data(), full.size())) {
+        if(!stateMismatches++) firstMismatch = frame;
+      }
+    }
+    times.append(time);
+    scriptTimes.append(program->script.time);
+    if(perFrame) print(frame, ",", time / 1000, ",", program->script.time / 1000, "\n");
+    if(profile) {
+      for(auto& entry : emulator->profile()) {
+        auto total = profiles.find([&](auto& p) { return p.name == entry.name; });
+        if(!total) { profiles.append(entry); continue; }
+        profiles[*total].nanoseconds += entry.nanoseconds;
+        profiles[*total].clocks += entry.clocks;
+        profiles[*total].switches += entry.switches;
+      }
+    }
+  }
+  auto elapsed = chrono::nanosecond() - start;
+
+  //the last frames were run on predicted input; wait for the rest of the remote input so that both players end
+  //with the same memory, which is printed for comparison. (save states also hold host pointers, which differ.)
+  Hash::CRC32 netplayMemory;
+  if(program->netplay) {
+    for(auto waitStart = chrono::nanosecond(); !program->netplay.synchronized();) {
+      if(chrono::nanosecond() - waitStart > 10'000'000'000ull) break;
+      program->netplay.idle();
+      if(netplayOnline) usleep(1000);
+    }
+    for(uint address : range(0x7e0000, 0x800000)) netplayMemory.input(emulator->read(address));
+  }
+
+  if(scriptLocation) emulator->unloadScript();
+  program->closeAudio();
+  program->output.video.close();
+  emulator->unload();
+
+  if(frames) {
+    uint64 scriptTotal = 0;
+    for(auto time : scriptTimes) scriptTotal += time;
+    auto sorted = times;
+    sorted.sort();
+
+    print("frames: ", frames, ", elapsed: ", elapsed / 1'000'000, " ms, ",
+      "fps: ", string{frames * 1'000'000'000.0 / max(1ull, elapsed)}.trimRight(".0", 1L), "\n");
+    print("frame us: min ", sorted.first() / 1000, ", p50 ", percentile(sorted, 50) / 1000,
+      ", p95 ", percentile(sorted, 95) / 1000, ", p99 ", percentile(sorted, 99) / 1000,
+      ", max ", sorted.last() / 1000, ", avg ", elapsed / frames / 1000, "\n");
+    print("script: ", scriptTotal / 1'000'000, " ms (", scriptTotal * 100 / max(1ull, elapsed), "%), ",
+      scriptTotal / frames / 1000, " us/frame\n");
+  }
+  if(frames && profile) {
+    print("component   us/frame  time%  clocks/frame  switches/frame\n");
+    for(auto& p : profiles) {
+      print(pad(p.name, -10), " ", pad(p.nanoseconds / frames / 1000, 9), " ",
+        pad(p.nanoseconds * 100 / max(1ull, elapsed), 6), " ",
+        pad(p.clocks / frames, 13), " ", pad(p.switches / frames, 15), "\n");
+    }
+  }
+  if(program->netplay) {
+    auto& m = program->netplay.metrics();
+    print("netplay: ", m.frames, " frames, ", program->netplay.confirmed(), " confirmed, ", m.stalls, " stalls, ",
+      m.rollbacks, " rollbacks (avg depth ", string{(double)m.resimulated / max(1ull, m.rollbacks)}.trimRight(".0", 1L),
+      ", max ", m.maxDepth, "), ", m.resimulated, " frames run again\n");
+    print("netplay: rollback ", m.resimulationTime / 1000 / max(1ull, m.rollbacks), " us each, ",
+      m.resimulationTime / 1'000'000, " ms total; state saves ", m.saveTime / 1000 / max(1ull, m.frames + m.resimulated),
+      " us each, ", m.saveTime / 1'000'000, " ms total\n");
+    print("netplay: sent ", m.packetsSent, " packets, ", m.bytesSent, " bytes (", m.bytesSent / max(1ull, m.frames),
+      " per frame); received ", m.packetsReceived, " packets, ", m.bytesReceived, " bytes\n");
+    print("netplay: ", program->netplay.synchronized() ? "synchronized" : "NOT synchronized",
+      ", wram crc32 ", hex(netplayMemory.value(), 8L), "\n");
+  }
+  print("video: ", program->output.frames, " frames, crc32 ", hex(program->output.videoHash.value(), 8L), "\n");
+  print("audio: ", program->output.samples, " samples, crc32 ", hex(program->output.audioHash.value(), 8L), "\n");
+
+  if(states) {
+    print("states: ", frames - stateMismatches, " of ", frames, " incremental states match full ones\n");
+    if(stateMismatches) {
+      print(stderr, "the incremental state first differs from a full one at frame ", *firstMismatch, "\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  if(filters && program->frame.pixels && !benchmarkFilters(program->frame)) {
+    print(stderr, "the vector kernels of a filter differ from the scalar ones\n");
+    exit(EXIT_FAILURE);
+  }
+
+  if(program->script.errors) {
+    print(stderr, program->script.errors, " script error(s)\n");
+    exit(EXIT_FAILURE);
+  }
+}
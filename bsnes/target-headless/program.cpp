@@ -0,0 +1,325 @@
+#include <emulator/emulator.hpp>
+#include <sfc/interface/interface.hpp>
+#include <lzma/lzma.hpp>
+#include <nall/directory.hpp>
+#include <nall/decode/zip.hpp>
+#include <nall/hash/crc32.hpp>
+using namespace nall;
+
+#include <filter/filter.hpp>
+
+#include <heuristics/heuristics.hpp>
+#include <heuristics/heuristics.cpp>
+#include <heuristics/super-famicom.cpp>
+#include <heuristics/game-boy.cpp>
+#include <heuristics/database.hpp>
+#include <heuristics/database.cpp>
+
+//the board database and IPL ROM are shared with the libretro target
+#include <target-libretro/resources.hpp>
+
+static Emulator::Interface* emulator = nullptr;
+
+struct Program : Emulator::Platform {
+  Program();
+
+  auto open(uint id, string name, vfs::file::mode mode, bool required) -> shared_pointer<vfs::file> override;
+  auto load(uint id, string name, string type, vector<string> options = {}) -> Emulator::Platform::Load override;
+  auto videoFrame(const uint16* data, uint pitch, uint width, uint height, uint scale) -> void override;
+  auto audioFrames(const double* samples, uint frames, uint channels) -> void override;
+  auto inputPoll(uint port, uint device, uint input) -> int16 override;
+
+  auto loadFile(string location) -> vector<uint8_t>;
+  auto loadSuperFamicom(string location) -> bool;
+  auto loadMovie(string location) -> bool;
+
+  auto openVideo(string location) -> bool;
+  auto openAudio(string location) -> bool;
+  auto closeAudio() -> void;
+
+  //script.cpp
+  auto scriptMessage(const string& msg, bool alert = false, ::Script::MessageLevel level = ::Script::MSG_INFO) -> void override;
+  auto scriptExecute(asIScriptContext* ctx) -> asUINT override;
+  auto scriptInit() -> void;
+  auto scriptLoad(string location) -> bool;
+
+  struct SuperFamicom {
+    string location;
+    string manifest;
+    string title;
+    string region;
+    vector<uint8_t> program;
+    vector<uint8_t> data;
+    vector<uint8_t> expansion;
+    vector<uint8_t> firmware;
+    bool verified = false;
+  } superFamicom;
+
+  //only consulted when given, so that runs do not depend on the database that happens to be installed
+  string databaseLocation;
+  Heuristics::Database database;
+
+  //when active, the two controller ports are played by the local and the remote player:
+  Emulator::Netplay netplay;
+
+  struct Movie {
+    serializer state;
+    vector<int16> input;  //every poll in order; frame boundaries are not needed for playback
+    uint position = 0;
+    bool active = false;
+  } movie;
+
+  struct Output {
+    file_buffer video;  //per frame: width (16-bit), height (16-bit), then width * height BGR555 pixels
+    file_buffer audio;  //16-bit stereo WAV; the sizes in the header are written when closed
+    uint64 samples = 0;
+    uint frames = 0;
+    Hash::CRC32 videoHash;
+    Hash::CRC32 audioHash;
+  } output;
+
+  //a copy of the last frame, only kept when the filters are to be benchmarked on it
+  struct Frame {
+    bool keep = false;
+    vector<uint16> pixels;
+    uint width = 0;
+    uint height = 0;
+  } frame;
+
+  struct Script {
+    uint64 time = 0;   //host nanoseconds spent executing script code; reset by the frame loop
+    uint depth = 0;    //nested executions are only timed once
+    uint errors = 0;
+  } script;
+};
+
+static Program* program = nullptr;
+
+Program::Program() {
+  Emulator::platform = this;
+}
+
+auto Program::open(uint id, string name, vfs::file::mode mode, bool required) -> shared_pointer<vfs::file> {
+  if(name == "ipl.rom" && mode == vfs::file::mode::read) {
+    return vfs::memory::file::open(iplrom, sizeof(iplrom));
+  }
+
+  if(name == "boards.bml" && mode == vfs::file::mode::read) {
+    return vfs::memory::file::open(Boards, sizeof(Boards));
+  }
+
+  if(id != 1) return {};
+
+  if(name == "manifest.bml" && mode == vfs::file::mode::read) {
+    return vfs::memory::file::open(superFamicom.manifest.data<uint8_t>(), superFamicom.manifest.size());
+  }
+
+  if(name == "program.rom" && mode == vfs::file::mode::read) {
+    return vfs::memory::file::open(superFamicom.program.data(), superFamicom.program.size());
+  }
+
+  if(name == "data.rom" && mode == vfs::file::mode::read) {
+    return vfs::memory::file::open(superFamicom.data.data(), superFamicom.data.size());
+  }
+
+  if(name == "expansion.rom" && mode == vfs::file::mode::read) {
+    return vfs::memory::file::open(superFamicom.expansion.data(), superFamicom.expansion.size());
+  }
+
+  if(name == "msu1/data.rom" && mode == vfs::file::mode::read) {
+    return vfs::fs::file::open({Location::notsuffix(superFamicom.location), ".msu"}, mode);
+  }
+
+  if(name.match("msu1/track*.pcm") && mode == vfs::file::mode::read) {
+    name.trimLeft("msu1/track", 1L);
+    return vfs::fs::file::open({Location::notsuffix(superFamicom.location), name}, mode);
+  }
+
+  //save RAM is neither loaded nor written, so that every run starts from the same state
+  return {};
+}
+
+auto Program::load(uint id, string name, string type, vector<string> options) -> Emulator::Platform::Load {
+  if(id == 1 && superFamicom.program) return {id, superFamicom.region};
+  return {};
+}
+
+auto Program::videoFrame(const uint16* data, uint pitch, uint width, uint height, uint scale) -> void {
+  output.frames++;
+  for(uint y : range(height)) {
+    auto line = (const uint8_t*)(data + y * (pitch >> 1));
+    output.videoHash.input(line, width * sizeof(uint16));
+  }
+
+  if(frame.keep) {
+    frame.width = width;
+    frame.height = height;
+    frame.pixels.resize(width * height);
+    for(uint y : range(height)) memory::copy<uint16>(&frame.pixels[y * width], data + y * (pitch >> 1), width);
+  }
+
+  if(!output.video) return;
+  output.video.writel(width, 2L);
+  output.video.writel(height, 2L);
+  for(uint y : range(height)) {
+    auto line = data + y * (pitch >> 1);
+    for(uint x : range(width)) output.video.writel(line[x], 2L);
+  }
+}
+
+auto Program::audioFrames(const double* samples, uint frames, uint channels) -> void {
+  for(uint n : range(frames)) {
+    for(uint c : range(2)) {
+      double sample = samples[n * channels + c] * 32768.0;
+      int16_t value = sample > 32767.0 ? 32767 : sample < -32768.0 ? -32768 : (int16_t)sample;
+      output.audioHash.input((uint8_t)(value >> 0));
+      output.audioHash.input((uint8_t)(value >> 8));
+      if(output.audio) output.audio.writel((uint16_t)value, 2L);
+    }
+  }
+  output.samples += frames;
+}
+
+auto Program::inputPoll(uint port, uint device, uint input) -> int16 {
+  if(netplay) {
+    if(device != ::SuperFamicom::ID::Device::Gamepad) return 0;
+    return netplay.input(port) >> input & 1;
+  }
+  if(!movie.active || movie.position >= movie.input.size()) return 0;
+  return movie.input[movie.position++];
+}
+
+auto Program::loadFile(string location) -> vector<uint8_t> {
+  if(Location::suffix(location).downcase() == ".zip") {
+    Decode::ZIP archive;
+    if(archive.open(location)) {
+      for(auto& file : archive.file) {
+        auto type = Location::suffix(file.name).downcase();
+        if(type == ".sfc" || type == ".smc" || type == ".bs" || type == ".st") {
+          return archive.extract(file);
+        }
+      }
+    }
+    return {};
+  }
+
+  if(Location::suffix(location).downcase() == ".7z") {
+    return LZMA::extract(location);
+  }
+
+  return file::read(location);
+}
+
+auto Program::loadSuperFamicom(string location) -> bool {
+  auto rom = loadFile(location);
+  if(rom.size() < 0x8000) return false;
+
+  if((rom.size() & 0x7fff) == 512) {
+    //remove copier header
+    memory::move(&rom[0], &rom[512], rom.size() - 512);
+    rom.resize(rom.size() - 512);
+  }
+
+  auto heuristics = Heuristics::SuperFamicom(rom, location);
+  superFamicom.location = location;
+  superFamicom.title = heuristics.title();
+  superFamicom.region = heuristics.videoRegion();
+  superFamicom.manifest = heuristics.manifest();
+  if(databaseLocation && database.open(databaseLocation)) {
+    if(auto game = database.find(Hash::SHA256(rom).digest())) {
+      superFamicom.manifest = BML::serialize(game);
+      //the internal ROM header title is not present in the database, but is needed for internal core overrides
+      superFamicom.manifest.append("  title: ", superFamicom.title, "\n");
+      superFamicom.verified = true;
+    }
+  }
+
+  uint offset = 0;
+  auto take = [&](vector<uint8_t>& target, uint size) {
+    size = min(size, (uint)rom.size() - offset);
+    if(!size) return;
+    target.resize(size);
+    memory::copy(target.data(), &rom[offset], size);
+    offset += size;
+  };
+  if(auto size = heuristics.programRomSize()) take(superFamicom.program, size);
+  if(auto size = heuristics.dataRomSize()) take(superFamicom.data, size);
+  if(auto size = heuristics.expansionRomSize()) take(superFamicom.expansion, size);
+  if(auto size = heuristics.firmwareRomSize()) take(superFamicom.firmware, size);
+  return (bool)superFamicom.program;
+}
+
+//reads the input of a BSV1 or BSV2 movie (see target-bsnes/program/movies.cpp);
+//BSV2 keyframes and the index are only needed for seeking, and are ignored here.
+auto Program::loadMovie(string location) -> bool {
+  auto fp = file::open(location, file::mode::read);
+  if(!fp) return false;
+  if(fp.read() != 'B' || fp.read() != 'S' || fp.read() != 'V') return false;
+  auto version = fp.read();
+  if(version != '1' && version != '2') return false;
+
+  uint32_t size = fp.readl(4L);
+  if(fp.size() - fp.offset() < size) return false;
+  if(size) {
+    vector<uint8_t> data;
+    data.resize(size);
+    fp.read({data.data(), size});
+    movie.state = serializer{data.data(), size};
+  }
+
+  if(version == '1') {
+    while(fp.size() - fp.offset() >= 2) movie.input.append(fp.readl(2L));
+  } else {
+    uint32_t frames = fp.readl(4L);
+    while(frames) {
+      if(fp.size() - fp.offset() < 6) return false;
+      uint32_t repeat = fp.readl(4L);
+      uint16_t count = fp.readl(2L);
+      if(!repeat || repeat > frames || fp.size() - fp.offset() < count * 2) return false;
+      vector<int16> polls;
+      for(uint n : range(count)) polls.append(fp.readl(2L));
+      for(uint n : range(repeat)) movie.input.append(polls);
+      frames -= repeat;
+    }
+  }
+
+  movie.position = 0;
+  movie.active = true;
+  return true;
+}
+
+auto Program::openVideo(string location) -> bool {
+  return output.video.open(location, file::mode::write);
+}
+
+auto Program::openAudio(string location) -> bool {
+  if(!output.audio.open(location, file::mode::write)) return false;
+  uint frequency = Emulator::audio.frequency();
+  auto tag = [&](const char* name) { for(uint n : range(4)) output.audio.write(name[n]); };
+  tag("RIFF");
+  output.audio.writel(0, 4L);  //written by closeAudio()
+  tag("WAVE");
+  tag("fmt ");
+  output.audio.writel(16, 4L);
+  output.audio.writel(1, 2L);  //PCM
+  output.audio.writel(2, 2L);  //channels
+  output.audio.writel(frequency, 4L);
+  output.audio.writel(frequency * 4, 4L);
+  output.audio.writel(4, 2L);
+  output.audio.writel(16, 2L);
+  tag("data");
+  output.audio.writel(0, 4L);  //written by closeAudio()
+  return true;
+}
+
+auto Program::closeAudio() -> void {
+  if(!output.audio) return;
+  uint32_t bytes = output.samples * 4;
+  output.audio.seek(4);
+  output.audio.writel(36 + bytes, 4L);
+  output.audio.seek(40);
+  output.audio.writel(bytes, 4L);
+  output.audio.close();
+}
+
+#include "script.cpp"
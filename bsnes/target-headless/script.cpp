@@ -0,0 +1,36 @@
+auto Program::scriptMessage(const string& msg, bool alert, ::Script::MessageLevel level) -> void {
+  if(level == ::Script::MSG_ERROR) script.errors++;
+  Emulator::Platform::scriptMessage(msg, alert, level);
+}
+
+//every script invocation, whether a frame hook, an interceptor or a call site, executes through here:
+auto Program::scriptExecute(asIScriptContext* ctx) -> asUINT {
+  if(script.depth++) {
+    auto r = Emulator::Platform::scriptExecute(ctx);
+    script.depth--;
+    return r;
+  }
+
+  auto start = chrono::nanosecond();
+  auto r = Emulator::Platform::scriptExecute(ctx);
+  script.time += chrono::nanosecond() - start;
+  script.depth--;
+  if(r == asEXECUTION_EXCEPTION) script.errors++;
+  return r;
+}
+
+auto Program::scriptInit() -> void {
+  scriptCreateEngine();
+  emulator->registerScriptDefs(this);
+  scriptCreatePrimaryContext();
+}
+
+auto Program::scriptLoad(string location) -> bool {
+  if(!inode::exists(location)) {
+    scriptMessage({"Script file '", location, "' not found"}, true, ::Script::MSG_ERROR);
+    return false;
+  }
+
+  emulator->loadScript(location);
+  return true;
+}
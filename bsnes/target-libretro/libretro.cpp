@@ -656,16 +656,28 @@ static void run_with_runahead(const int frames)
 {
 	assert(frames > 0);
 
+	// authoritative frame: produces audio; the snapshot is updated in place
+	static serializer state;
+	static uint generation = 0;
 	emulator->setRunAhead(true);
 	emulator->run();
-	auto state = emulator->serialize(0);
+	bool incremental = emulator->serialize(state, generation);
+	if (!incremental)
+		state = emulator->serialize(0);
+
+	// speculative frames: discarded after the last one is displayed
+	emulator->setSpeculative(true);
 	for (int i = 0; i < frames - 1; ++i) {
 		emulator->run();
 	}
 	emulator->setRunAhead(false);
 	emulator->run();
-	state.setMode(serializer::Mode::Load);
-	emulator->unserialize(state);
+	emulator->setSpeculative(false);
+	if (!incremental || !emulator->unserialize(state, generation)) {
+		state.setMode(serializer::Mode::Load);
+		emulator->unserialize(state);
+		generation = 0;
+	}
 }
 
 RETRO_API void retro_run()
@@ -28,7 +28,7 @@ struct Program : Emulator::Platform
 	auto open(uint id, string name, vfs::file::mode mode, bool required) -> shared_pointer<vfs::file> override;
 	auto load(uint id, string name, string type, vector<string> options = {}) -> Emulator::Platform::Load override;
 	auto videoFrame(const uint16* data, uint pitch, uint width, uint height, uint scale) -> void override;
-	auto audioFrame(const double* samples, uint channels) -> void override;
+	auto audioFrames(const double* samples, uint frames, uint channels) -> void override;
 	auto inputPoll(uint port, uint device, uint input) -> int16 override;
 	auto inputRumble(uint port, uint device, uint input, bool enable) -> void override;
 	
@@ -280,12 +280,15 @@ static int16_t d2i16(double v)
 	return int16_t(floor(v + 0.5));
 }
 
-auto Program::audioFrame(const double* samples, uint channels) -> void
+auto Program::audioFrames(const double* samples, uint frames, uint channels) -> void
 {
-	int16_t left = d2i16(samples[0]);
-	int16_t right = d2i16(samples[1]);
-	//audio_cb(left, right);
-	audio_queue(left, right);
+	for (uint n = 0; n < frames; n++)
+	{
+		int16_t left = d2i16(samples[n * channels + 0]);
+		int16_t right = d2i16(samples[n * channels + 1]);
+		//audio_cb(left, right);
+		audio_queue(left, right);
+	}
 }
 
 auto pollInputDevices(uint port, uint device, uint input) -> int16
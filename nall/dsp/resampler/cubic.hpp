@@ -12,7 +12,7 @@ struct Cubic {
 
   inline auto reset(double inputFrequency, double outputFrequency = 0, uint queueSize = 0) -> void;
   inline auto setInputFrequency(double inputFrequency) -> void;
-  inline auto pending() const -> bool;
+  inline auto pending() const -> uint;
   inline auto read() -> double;
   inline auto write(double sample) -> void;
   inline auto serialize(serializer&) -> void;
@@ -42,8 +42,8 @@ auto Cubic::setInputFrequency(double inputFrequency) -> void {
   _ratio = _inputFrequency / _outputFrequency;
 }
 
-auto Cubic::pending() const -> bool {
-  return _samples.pending();
+auto Cubic::pending() const -> uint {
+  return _samples.size();
 }
 
 auto Cubic::read() -> double {
@@ -128,6 +128,13 @@ struct serializer {
     return array(data, N);
   }
 
+  //advances past data without reading or writing it;
+  //used to leave unchanged regions of a reused Save buffer intact
+  auto skip(uint size) -> serializer& {
+    _size += size;
+    return *this;
+  }
+
   //nall/serializer saves data in little-endian ordering
   #if defined(ENDIAN_LSB)
   auto array(uint16_t* data, uint size) -> serializer& { return array((uint8_t*)data, size * sizeof(uint16_t)); }
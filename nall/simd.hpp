@@ -1,11 +1,18 @@
 #pragma once
 
-namespace nall {
+//the widest vector extension the compiler targets; AVX2 builds can also use the SSE2 paths
 
 #if defined(__AVX2__)
   #define SIMD 256
   #define SIMD_AVX2
+  #define SIMD_SSE2
   #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+  #define SIMD 128
+  #define SIMD_SSE2
+  #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+  #define SIMD 128
+  #define SIMD_NEON
+  #include <arm_neon.h>
 #endif
-
-}
@@ -66,13 +66,15 @@ template<typename T> auto vector<T>::append(vector<T>&& values) -> void {
 
 template<typename T> auto vector<T>::insert(uint64_t offset, const T& value) -> void {
   if(offset == 0) return prepend(value);
-  if(offset == size() - 1) return append(value);
+  if(offset == size()) return append(value);
   reserveRight(size() + 1);
-  _size++;
-  for(int64_t n = size() - 1; n > offset; n--) {
+  new(_pool + _size) T(move(_pool[_size - 1]));
+  for(int64_t n = _size - 1; n > offset; n--) {
     _pool[n] = move(_pool[n - 1]);
   }
-  new(_pool + offset) T(value);
+  _pool[offset] = value;
+  _right--;
+  _size++;
 }
 
 //
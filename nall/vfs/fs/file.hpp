@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nall/file.hpp>
+#include <nall/file-map.hpp>
 
 namespace nall::vfs::fs {
 
@@ -35,6 +36,12 @@ struct file : vfs::file {
     _fp.flush();
   }
 
+  //files opened for reading are memory-mapped on first use
+  auto data() const -> const uint8_t* override {
+    if(!_map && _mode == mode::read) _map.open(_location, file_map::mode::read);
+    return _map.data();
+  }
+
 private:
   file() = default;
   file(const file&) = delete;
@@ -42,10 +49,15 @@ private:
 
   auto _open(string location_, mode mode_) -> bool {
     if(!_fp.open(location_, (uint)mode_)) return false;
+    _location = location_;
+    _mode = mode_;
     return true;
   }
 
   file_buffer _fp;
+  string _location;
+  mode _mode = mode::read;
+  mutable file_map _map;
 };
 
 }
@@ -29,7 +29,7 @@ struct file : vfs::file {
     return instance;
   }
 
-  auto data() const -> const uint8_t* { return _data; }
+  auto data() const -> const uint8_t* override { return _data; }
   auto size() const -> uintmax override { return _size; }
   auto offset() const -> uintmax override { return _offset; }
 
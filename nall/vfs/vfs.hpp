@@ -19,6 +19,9 @@ struct file {
   virtual auto write(uint8_t data) -> void = 0;
   virtual auto flush() -> void {}
 
+  //the whole file in memory, if it can be accessed directly; otherwise nullptr
+  virtual auto data() const -> const uint8_t* { return nullptr; }
+
   auto end() const -> bool {
     return offset() >= size();
   }
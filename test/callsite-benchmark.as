@@ -0,0 +1,60 @@
+// script to benchmark the per-call cost of native -> script hook invocations.
+// run with audio/video sync disabled; build before and after a change to compare.
+// measures frame time without any interceptor first, then with a write interceptor covering
+// all of WRAM until one million hook invocations have been counted, and reports the difference
+// per invocation.
+
+const uint baseline_frames = 300;
+const uint target_calls = 1000000;
+
+uint phase = 0;
+uint frame = 0;
+uint calls = 0;
+uint64 start_ns = 0;
+uint64 baseline_ns = 0;
+uint64 hooked_ns = 0;
+
+void written(uint32 addr, uint8 oldValue, uint8 newValue) {
+  calls++;
+}
+
+void post_power(bool reset) {
+  phase = 0;
+  frame = 0;
+  calls = 0;
+  baseline_ns = 0;
+  hooked_ns = 0;
+}
+
+void pre_frame() {
+  start_ns = chrono::monotonic::nanosecond;
+}
+
+void post_frame() {
+  if (start_ns == 0) return;
+  auto elapsed = chrono::monotonic::nanosecond - start_ns;
+
+  if (phase == 0) {
+    baseline_ns += elapsed;
+    frame++;
+    if (frame < baseline_frames) return;
+
+    bus::add_write_interceptor("7e-7f:0000-ffff", @written);
+    phase = 1;
+    frame = 0;
+    return;
+  }
+
+  if (phase != 1) return;
+  hooked_ns += elapsed;
+  frame++;
+  if (calls < target_calls) return;
+
+  auto baseline_per_frame = double(baseline_ns) / double(baseline_frames);
+  auto overhead_ns = double(hooked_ns) - baseline_per_frame * double(frame);
+  message("callsite-benchmark: calls=" + fmtUint(calls) +
+          " frames=" + fmtInt(frame) +
+          " baseline us/frame=" + fmtDouble(baseline_per_frame / 1000.0) +
+          " ns/call=" + fmtDouble(overhead_ns / double(calls)));
+  phase = 2;
+}
@@ -0,0 +1,78 @@
+// script to benchmark the 65816 interpreter in instructions per second.
+// copies a known loop into WRAM and points the CPU at it; each iteration executes 39 instructions
+// (switching between 8-bit and 16-bit M/X modes) and increments a 16-bit counter at $7E1F00.
+// the rate is measured against the host time of the CPU thread reported by the scheduler profiler,
+// so that PPU, SMP and script time are excluded. run with audio/video sync disabled.
+
+const uint frames_per_report = 600;
+const uint instructions_per_iteration = 39;
+const uint32 loop_addr = 0x7e2000;
+const uint32 counter_addr = 0x7e1f00;
+
+const array<uint8> loop = {
+  0x78,                    // $2000: sei
+  0x18,                    //        clc
+  0xfb,                    //        xce          ; native mode, so interrupts return to bank $7e
+  0xc2, 0x30,              //        rep #$30
+  0xa2, 0xff, 0x1f,        //        ldx #$1fff
+  0x9a,                    //        txs          ; the stack may be anywhere when the CPU is redirected
+  0xc2, 0x30,              // $2009: rep #$30
+  0xaf, 0x00, 0x1f, 0x7e,  //        lda $7e1f00
+  0x1a,                    //        inc
+  0x8f, 0x00, 0x1f, 0x7e,  //        sta $7e1f00
+  0xe2, 0x30,              //        sep #$30
+  0xa2, 0x10,              //        ldx #$10
+  0xca,                    // $2018: dex
+  0xd0, 0xfd,              //        bne $2018
+  0x80, 0xec               //        bra $2009
+};
+
+bool running = false;
+uint16 last_counter = 0;
+uint frames = 0;
+uint64 iterations = 0;
+uint64 cpu_ns = 0;
+
+void init() {
+  perf::enabled = true;
+}
+
+void unload() {
+  perf::enabled = false;
+}
+
+void pre_frame() {
+  if (running) return;
+
+  // keep redirecting the CPU until the loop has taken over; interrupt handlers return into it:
+  for (uint i = 0; i < loop.length(); i++) {
+    bus::write_u8(loop_addr + i, loop[i]);
+  }
+  bus::write_u16(counter_addr, 0);
+  cpu::r.pc = loop_addr;
+  last_counter = 0;
+}
+
+void post_frame() {
+  uint16 counter = bus::read_u16(counter_addr);
+  uint16 delta = counter - last_counter;
+  last_counter = counter;
+  if (!running) {
+    running = delta != 0;
+    return;
+  }
+
+  frames++;
+  iterations += delta;
+  cpu_ns += perf::frame_stats.nanoseconds(perf::cpu);
+  if (frames < frames_per_report) return;
+
+  auto instructions = iterations * instructions_per_iteration;
+  message("cpu-benchmark: frames=" + fmtInt(frames) +
+          " instructions=" + fmtInt(instructions) +
+          " cpu_ms=" + fmtInt(cpu_ns / 1000000) +
+          " mips=" + fmtDouble(double(instructions) * 1000.0 / double(cpu_ns)));
+  frames = 0;
+  iterations = 0;
+  cpu_ns = 0;
+}
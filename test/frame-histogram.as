@@ -0,0 +1,46 @@
+// script to record a histogram of host frame times.
+// run with audio/video sync disabled; compare different Hacks/PPU/Threads settings (or builds)
+// to measure the fast PPU scanline renderer. buckets are 0.5ms wide; the last bucket collects the rest.
+
+const uint frames_per_report = 1200;
+const uint bucket_count = 40;
+const double bucket_us = 500.0;
+
+array<uint> buckets(bucket_count);
+uint frames = 0;
+uint64 last_ns = 0;
+uint64 total_ns = 0;
+uint64 worst_ns = 0;
+
+void post_frame() {
+  auto now = chrono::monotonic::nanosecond;
+  if (last_ns == 0) {
+    last_ns = now;
+    return;
+  }
+
+  auto elapsed = now - last_ns;
+  last_ns = now;
+
+  uint bucket = uint(double(elapsed) / 1000.0 / bucket_us);
+  if (bucket >= bucket_count) bucket = bucket_count - 1;
+  buckets[bucket]++;
+  total_ns += elapsed;
+  if (elapsed > worst_ns) worst_ns = elapsed;
+
+  frames++;
+  if (frames < frames_per_report) return;
+
+  message("frame-histogram: frames=" + fmtInt(frames) +
+          " mean us=" + fmtDouble(double(total_ns) / double(frames) / 1000.0) +
+          " worst us=" + fmtDouble(double(worst_ns) / 1000.0));
+  for (uint i = 0; i < bucket_count; i++) {
+    if (buckets[i] == 0) continue;
+    message("  " + fmtDouble(i * bucket_us / 1000.0) + "ms: " + fmtInt(buckets[i]));
+    buckets[i] = 0;
+  }
+
+  frames = 0;
+  total_ns = 0;
+  worst_ns = 0;
+}
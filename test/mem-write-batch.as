@@ -0,0 +1,19 @@
+// script to test buffered memory-write intercepts delivered once per frame.
+uint frames = 0;
+
+void wram_written(bus::WriteBatch @batch) {
+  frames++;
+  if ((frames & 63) != 0) return;
+
+  message("frame " + fmtInt(frames) + ": " + fmtInt(batch.length) + " writes to 7e:0000-00ff");
+  auto len = batch.length;
+  if (len > 8) len = 8;
+  for (uint i = 0; i < len; i++) {
+    auto @w = batch[i];
+    message("  @" + fmtInt(w.cycle) + " 0x" + fmtHex(w.addr, 6) + ": 0x" + fmtHex(w.old_value, 2) + " -> 0x" + fmtHex(w.new_value, 2));
+  }
+}
+
+void init() {
+  bus::add_write_interceptor_buffered("7e:0000-00ff", @wram_written);
+}
@@ -0,0 +1,42 @@
+// TCP echo server that checks all of its sockets with a single net::Poller call per frame
+net::Socket@ server;
+net::Poller@ poller;
+array<uint8> buffer(4096);
+
+void init() {
+  auto@ addr = net::resolve_tcp("127.0.0.1", "4590");
+  @server = net::Socket(addr);
+  server.bind(addr);
+  server.listen(32);
+
+  @poller = net::Poller();
+  poller.add(server, net::readable);
+}
+
+void pre_frame() {
+  if (poller.poll() == 0) {
+    return;
+  }
+
+  for (uint i = 0; i < poller.ready_count; i++) {
+    auto@ sock = poller.ready[i];
+    if (@sock is @server) {
+      // accept every pending connection:
+      for (auto@ client = server.accept(); client !is null; @client = server.accept()) {
+        poller.add(client, net::readable);
+        message("accepted; watching " + fmtInt(poller.count) + " sockets");
+      }
+      continue;
+    }
+
+    int n = sock.recv(0, buffer.length(), buffer);
+    if (n <= 0 || (poller.events[i] & net::closed) != 0) {
+      // closed sockets are dropped from the poller on its next poll():
+      sock.close();
+      message("closed");
+      continue;
+    }
+
+    sock.send(0, n, buffer);
+  }
+}
@@ -0,0 +1,39 @@
+// WebSocket echo server whose sockets are read and written by a net::Worker thread;
+// the script only drains queued events and enqueues replies, so it makes no socket calls per frame.
+net::Worker@ worker;
+int listener;
+
+void init() {
+  @worker = net::Worker();
+  listener = worker.listen_websocket("ws://127.0.0.1:4590/");
+  if (listener < 0) {
+    message("listen failed: " + net::error_code + " " + net::error_text);
+  }
+}
+
+void pre_frame() {
+  for (auto@ ev = worker.poll(); ev !is null; @ev = worker.poll()) {
+    if (ev.kind == net::opened) {
+      if (ev.server == listener) {
+        message("client " + fmtInt(ev.channel) + " connected");
+      }
+      continue;
+    }
+
+    if (ev.kind == net::disconnected) {
+      message("channel " + fmtInt(ev.channel) + " closed " + ev.error_text);
+      continue;
+    }
+
+    auto@ msg = ev.message;
+    if (msg.opcode == 8) {
+      // close frame; the worker closes the socket once the reply is sent:
+      worker.send(ev.channel, msg);
+      worker.close(ev.channel);
+      continue;
+    }
+
+    // echo every other message back:
+    worker.send(ev.channel, msg);
+  }
+}
@@ -0,0 +1,74 @@
+// script to benchmark CPU::main() overhead with 0, 1, 16 and 1024 PC interceptors registered.
+// run with audio/video sync disabled so frames are emulated as fast as possible.
+// hooks are spread across the first 16 LoROM banks; their callbacks do nothing but count hits.
+
+const uint frames_per_phase = 600;
+const array<uint> hook_counts = {0, 1, 16, 1024};
+
+uint phase = 0;
+uint frame = 0;
+uint hits = 0;
+uint64 start_ns = 0;
+uint64 total_ns = 0;
+array<uint32> registered;
+
+void pc_hook(uint32 addr) {
+  hits++;
+}
+
+uint32 hook_addr(uint i) {
+  // spread hooks over banks $00-$0F, $8000-$FFFF, avoiding exact page boundaries:
+  return ((i & 15) << 16) | 0x8000 | (((i >> 4) * 0x1f3) & 0x7fff) | 1;
+}
+
+void begin_phase() {
+  for (uint i = 0; i < registered.length(); i++) {
+    cpu::unregister_pc_interceptor(registered[i]);
+  }
+  registered.resize(0);
+
+  for (uint i = 0; i < hook_counts[phase]; i++) {
+    auto addr = hook_addr(i);
+    cpu::register_pc_interceptor(addr, @pc_hook);
+    registered.insertLast(addr);
+  }
+
+  frame = 0;
+  hits = 0;
+  total_ns = 0;
+}
+
+void post_power(bool reset) {
+  phase = 0;
+  begin_phase();
+}
+
+void pre_frame() {
+  start_ns = chrono::monotonic::nanosecond;
+}
+
+void post_frame() {
+  if (phase >= hook_counts.length()) return;
+  if (start_ns == 0) return;
+
+  total_ns += chrono::monotonic::nanosecond - start_ns;
+  frame++;
+  if (frame < frames_per_phase) return;
+
+  auto us_per_frame = double(total_ns) / double(frames_per_phase) / 1000.0;
+  message("pc-benchmark: hooks=" + fmtInt(hook_counts[phase]) +
+          " frames=" + fmtInt(frames_per_phase) +
+          " us/frame=" + fmtDouble(us_per_frame) +
+          " frames/sec=" + fmtDouble(1000000.0 / us_per_frame) +
+          " hits=" + fmtInt(hits));
+
+  phase++;
+  if (phase < hook_counts.length()) {
+    begin_phase();
+  } else {
+    for (uint i = 0; i < registered.length(); i++) {
+      cpu::unregister_pc_interceptor(registered[i]);
+    }
+    registered.resize(0);
+  }
+}
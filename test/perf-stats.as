@@ -0,0 +1,34 @@
+// script to report where host time goes each frame, per emulated component.
+// enables the scheduler profiler and prints a breakdown of the last completed frame every second:
+// host microseconds, emulated clocks and switches into each component that ran.
+
+const uint frames_per_report = 60;
+
+uint frame = 0;
+
+void init() {
+  perf::enabled = true;
+}
+
+void unload() {
+  perf::enabled = false;
+}
+
+void post_frame() {
+  if (++frame % frames_per_report != 0) return;
+
+  auto @stats = perf::frame_stats;
+  message("frame " + fmtInt(frame) + ": " + fmtInt(stats.total_nanoseconds / 1000) + " us");
+  for (uint c = 0; c < perf::components; c++) {
+    auto component = perf::component(c);
+    auto ns = stats.nanoseconds(component);
+    if (ns == 0) continue;
+
+    uint64 switches = 0;
+    for (uint from = 0; from < perf::components; from++) {
+      switches += stats.switches(perf::component(from), component);
+    }
+    message("  " + perf::name(component) + ": " + fmtInt(ns / 1000) + " us, "
+      + fmtInt(stats.clocks(component)) + " clocks, " + fmtInt(switches) + " switches");
+  }
+}
@@ -0,0 +1,24 @@
+// Observes the built-in usb2snes server; run with --configure=Network/Usb2snes/Enable=true
+// and point a usb2snes client at ws://127.0.0.1:23074/.
+void init() {
+  usb2snes::subscribe(@on_request);
+}
+
+void on_request(usb2snes::Request @request) {
+  string operands;
+  for (uint i = 0; i < request.operand_count; i++) {
+    operands += " " + request.operands[i];
+  }
+  message("usb2snes: " + request.name + " " + request.opcode + " " + request.space + operands);
+
+  // answer an opcode the server does not know:
+  if (request.opcode == "ScriptVersion") {
+    request.reply("usb2snes.as");
+    request.reply("1");
+  }
+}
+
+void pre_frame() {
+  // a changing value for clients to watch at $F50100:
+  bus::write_u8(0x7E0100, bus::read_u8(0x7E0100) + 1);
+}
@@ -0,0 +1,60 @@
+// script to benchmark Bus::write() overhead with and without write interceptors registered.
+// run with audio/video sync disabled on a write-heavy ROM so frames are emulated as fast as possible.
+// write interceptors cannot be removed once added, so the phases only ever add coverage:
+//   phase 0: no interceptors at all
+//   phase 1: an interceptor on an address range the game should never write to
+//   phase 2: an interceptor covering all of WRAM bank $7E
+
+const uint frames_per_phase = 600;
+
+uint phase = 0;
+uint frame = 0;
+uint writes = 0;
+uint64 start_ns = 0;
+uint64 total_ns = 0;
+
+void written(uint32 addr, uint8 oldValue, uint8 newValue) {
+  writes++;
+}
+
+void begin_phase() {
+  if (phase == 1) {
+    bus::add_write_interceptor("40-43:0000-0fff", @written);
+  } else if (phase == 2) {
+    bus::add_write_interceptor("7e:0000-ffff", @written);
+  }
+
+  frame = 0;
+  writes = 0;
+  total_ns = 0;
+}
+
+void post_power(bool reset) {
+  phase = 0;
+  begin_phase();
+}
+
+void pre_frame() {
+  start_ns = chrono::monotonic::nanosecond;
+}
+
+void post_frame() {
+  if (phase > 2) return;
+  if (start_ns == 0) return;
+
+  total_ns += chrono::monotonic::nanosecond - start_ns;
+  frame++;
+  if (frame < frames_per_phase) return;
+
+  auto us_per_frame = double(total_ns) / double(frames_per_phase) / 1000.0;
+  message("write-benchmark: phase=" + fmtInt(phase) +
+          " frames=" + fmtInt(frames_per_phase) +
+          " us/frame=" + fmtDouble(us_per_frame) +
+          " frames/sec=" + fmtDouble(1000000.0 / us_per_frame) +
+          " intercepted=" + fmtInt(writes));
+
+  phase++;
+  if (phase <= 2) {
+    begin_phase();
+  }
+}